@@ -0,0 +1,99 @@
+#include <chrono>
+#include <cstdio>
+#include <mlc/core/all.h>
+#include <thread>
+
+namespace {
+using namespace mlc;
+
+template <typename Body> void Run(const char *name, int64_t num_ops, Body body) {
+  body(); // warm up
+  auto start = std::chrono::steady_clock::now();
+  int64_t num_repeats = 5;
+  for (int64_t i = 0; i < num_repeats; ++i) {
+    body();
+  }
+  auto end = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(end - start).count();
+  std::printf("%-40s %10.2f ns/op\n", name, ns / static_cast<double>(num_repeats * num_ops));
+}
+
+UList MakeTree(int32_t depth) {
+  UList ret;
+  if (depth == 0) {
+    ret.push_back(1);
+    ret.push_back("leaf");
+    ret.push_back(2.5);
+    return ret;
+  }
+  for (int i = 0; i < 4; ++i) {
+    ret.push_back(MakeTree(depth - 1));
+  }
+  return ret;
+}
+
+void BenchUListPushPop() {
+  constexpr int64_t kNum = 1 << 20;
+  Str item("an object whose reference count is updated on every push and pop");
+  UList list;
+  list.reserve(kNum);
+  Run("UList push/pop of an object", kNum, [&]() {
+    for (int64_t i = 0; i < kNum; ++i) {
+      list.push_back(item);
+    }
+    for (int64_t i = 0; i < kNum; ++i) {
+      list.pop_back();
+    }
+  });
+}
+
+void BenchUListCopy() {
+  constexpr int64_t kNum = 1 << 16;
+  UList list;
+  for (int64_t i = 0; i < kNum; ++i) {
+    list.push_back(Str("item"));
+  }
+  Run("UList copy of objects", kNum, [&]() {
+    UList copy(list.begin(), list.end());
+    copy.clear();
+  });
+}
+
+void BenchUListPushPopShared() {
+  // The object is owned by another thread, so every update goes through the shared count
+  constexpr int64_t kNum = 1 << 20;
+  Optional<Str> item;
+  std::thread([&item]() { item = Str("an object allocated by another thread"); }).join();
+  UList list;
+  list.reserve(kNum);
+  Run("UList push/pop of a foreign object", kNum, [&]() {
+    for (int64_t i = 0; i < kNum; ++i) {
+      list.push_back(item.value());
+    }
+    for (int64_t i = 0; i < kNum; ++i) {
+      list.pop_back();
+    }
+  });
+}
+
+void BenchStructuralHash() {
+  Func structural_hash(Lib::FuncGetGlobal("mlc.core.StructuralHash"));
+  Func structural_hash_128(Lib::FuncGetGlobal("mlc.core.StructuralHash128"));
+  UList tree = MakeTree(7);
+  int64_t num_nodes = 0;
+  for (int64_t n = 1, i = 0; i <= 7; ++i, n *= 4) {
+    num_nodes += n;
+  }
+  Run("StructuralHash of a nested UList", num_nodes, [&]() { structural_hash(tree); });
+  Run("StructuralHash128 of a nested UList", num_nodes, [&]() { structural_hash_128(tree); });
+}
+} // namespace
+
+int main() {
+  std::printf("MLC_BIASED_REFCOUNT = %d\n", MLC_BIASED_REFCOUNT);
+  BenchUListPushPop();
+  BenchUListPushPopShared();
+  BenchUListCopy();
+  BenchStructuralHash();
+  return 0;
+}
@@ -1,10 +1,23 @@
 #include "./registry.h"
+#include <atomic>
+#include <condition_variable>
 #include <mlc/core/all.h>
+#include <thread>
 
 namespace mlc {
 namespace registry {
 TypeTable *TypeTable::Global() {
-  static TypeTable *instance = TypeTable::New();
+  static TypeTable *instance = []() {
+    TypeTable *ret = TypeTable::New();
+    // The global type table is never destroyed, and never drops interned strings, so they can skip refcounting
+    ret->pool.MakeInternedImmortal();
+    return ret;
+  }();
+  // Functions and other objects can be replaced and freed while running, so they only become immortal at exit
+  static struct ImmortalAtExit {
+    ~ImmortalAtExit() { instance->pool.MakeImmortal(); }
+  } immortal_at_exit;
+  (void)immortal_at_exit;
   return instance;
 }
 UDict BuildInfo() {
@@ -38,6 +51,164 @@ UDict BuildInfo() {
   }();
   return build_info;
 }
+
+/*!
+ * \brief Frees garbage on a dedicated thread, so that releasing a large object graph does not stall the
+ * thread dropping its last reference. Leaked on purpose so that it outlives all other static objects.
+ */
+struct BackgroundReclaimer : public MLCReclaimer {
+  static BackgroundReclaimer *Global() {
+    static BackgroundReclaimer *instance = new BackgroundReclaimer();
+    return instance;
+  }
+
+  static void Submit(MLCAny *obj) {
+    BackgroundReclaimer *self = Global();
+    {
+      std::lock_guard<std::mutex> lock(self->mutex);
+      self->queue.push_back(obj);
+    }
+    self->cv_work.notify_one();
+  }
+
+  void SetEnabled(bool enabled) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if (enabled) {
+      if (!this->thread_started) {
+        this->thread_started = true;
+        std::thread([this]() { this->Run(); }).detach();
+      }
+      this->StoreEnabled(1);
+    } else {
+      // Objects may still be submitted by threads that observed the flag before it is cleared
+      this->StoreEnabled(0);
+      this->cv_idle.wait(lock, [this]() { return this->queue.empty() && !this->busy; });
+    }
+  }
+
+private:
+  BackgroundReclaimer() : MLCReclaimer{0, &BackgroundReclaimer::Submit} {}
+
+  void StoreEnabled(int32_t value) {
+#ifdef _MSC_VER
+    _InterlockedExchange(reinterpret_cast<volatile long *>(&this->enabled), value);
+#else
+    __atomic_store_n(&this->enabled, value, __ATOMIC_RELAXED);
+#endif
+  }
+
+  void Run() {
+    std::vector<MLCAny *> batch;
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true) {
+      this->cv_work.wait(lock, [this]() { return !this->queue.empty(); });
+      batch.swap(this->queue);
+      this->busy = true;
+      lock.unlock();
+      for (MLCAny *obj : batch) {
+        ::mlc::base::DrainFree(obj);
+      }
+      batch.clear();
+      lock.lock();
+      this->busy = false;
+      if (this->queue.empty()) {
+        this->cv_idle.notify_all();
+      }
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv_work;
+  std::condition_variable cv_idle;
+  std::vector<MLCAny *> queue;
+  bool busy = false;
+  bool thread_started = false;
+};
+
+void ReclaimInBackground(bool enabled) { BackgroundReclaimer::Global()->SetEnabled(enabled); }
+
+/*!
+ * \brief Per-thread record of biased reference counting, where other threads queue the objects owned by
+ * this thread whose shared counts went negative. Records are never freed, because objects keep pointing to
+ * them after their threads exit; all of them are chained from `head`.
+ */
+struct BiasedThread : public MLCBiasedThread {
+  static BiasedThread *Current() {
+    struct Holder {
+      BiasedThread *self = BiasedThread::Create();
+      ~Holder() { self->Exit(); }
+    };
+    static thread_local Holder holder;
+    return holder.self;
+  }
+
+  void Queue(MLCAny *obj) {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->alive) {
+        this->queue.push_back(obj);
+        StoreHasQueued(1);
+        return;
+      }
+    }
+    // Nobody is left to merge on behalf of an exited owner
+    Merge({obj});
+  }
+
+  void Flush() { Merge(this->Take()); }
+
+private:
+  BiasedThread() : MLCBiasedThread{1, 0, 1} {}
+
+  static BiasedThread *Create() {
+    static std::atomic<BiasedThread *> head{nullptr};
+    BiasedThread *self = new BiasedThread();
+    self->next = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(self->next, self, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return self;
+  }
+
+  void Exit() {
+    std::vector<MLCAny *> objs;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->alive = 0;
+      objs.swap(this->queue);
+      StoreHasQueued(0);
+    }
+    Merge(std::move(objs));
+  }
+
+  std::vector<MLCAny *> Take() {
+    std::vector<MLCAny *> objs;
+    std::lock_guard<std::mutex> lock(this->mutex);
+    objs.swap(this->queue);
+    StoreHasQueued(0);
+    return objs;
+  }
+
+  void StoreHasQueued(int32_t value) {
+#ifdef _MSC_VER
+    _InterlockedExchange(reinterpret_cast<volatile long *>(&this->has_queued), value);
+#else
+    __atomic_store_n(&this->has_queued, value, __ATOMIC_RELAXED);
+#endif
+  }
+
+  static void Merge([[maybe_unused]] std::vector<MLCAny *> objs) {
+#if MLC_BIASED_REFCOUNT == 1
+    for (MLCAny *obj : objs) {
+      ::mlc::base::BiasedMerge(obj, true);
+    }
+#endif
+  }
+
+  std::mutex mutex;
+  std::vector<MLCAny *> queue;
+  BiasedThread *next = nullptr;
+};
+
 } // namespace registry
 } // namespace mlc
 
@@ -237,6 +408,21 @@ MLC_API void MLCExtObjDelete(void *objptr) {
   }
 }
 
+MLC_API void **MLCArenaThreadLocal() {
+  static thread_local void *current = nullptr;
+  return &current;
+}
+
+MLC_API MLCReclaimer *MLCGetReclaimer() { return ::mlc::registry::BackgroundReclaimer::Global(); }
+
+MLC_API MLCBiasedThread *MLCBiasedThreadGet() { return ::mlc::registry::BiasedThread::Current(); }
+
+MLC_API void MLCBiasedThreadQueue(MLCBiasedThread *owner, MLCAny *obj) {
+  static_cast<::mlc::registry::BiasedThread *>(owner)->Queue(obj);
+}
+
+MLC_API void MLCBiasedThreadFlush() { ::mlc::registry::BiasedThread::Current()->Flush(); }
+
 MLC_API int32_t MLCHandleGetGlobal(MLCTypeTableHandle *self) {
   MLC_SAFE_CALL_BEGIN();
   *self = TypeTable::Global();
@@ -711,6 +711,8 @@ inline void PythonDocPrinter::PrintTypedDoc(const Literal &doc) {
     }
   } else if (type_index == kMLCStr) {
     (value.operator mlc::Str())->PrintEscape(output_);
+  } else if (type_index == kMLCSmallStr) {
+    StrObj::PrintEscape(value.v.v_bytes, value.small_len, output_);
   } else {
     MLC_THROW(TypeError) << "TypeError: Unsupported literal value type: " << value.GetTypeKey();
   }
@@ -11,7 +11,9 @@
 #include <memory>
 #include <mlc/core/all.h>
 #include <mlc/printer/all.h>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -21,12 +23,39 @@ namespace registry {
 Any JSONLoads(AnyView json_str);
 Any JSONDeserialize(AnyView json_str);
 Str JSONSerialize(AnyView source);
+void JSONSerializeTo(AnyView source, AnyView sink, AnyView tensor_sink);
+Any JSONDeserializeFrom(int64_t fd, int64_t offset, AnyView tensor_file);
+Any JSONDeserializeTensorFile(Str json_str, Str tensor_file);
+Str BinarySerialize(AnyView source);
+Any BinaryDeserialize(Str source);
+Any BinaryDeserializeBytes(void *data, int64_t num_bytes);
+void BinarySerializeTo(AnyView source, AnyView sink);
+Any BinaryDeserializeFrom(int64_t fd, int64_t offset);
+void *MappedBinaryOpen(Str path);
+void MappedBinaryDelete(void *handle);
+int64_t MappedBinarySize(void *handle);
+Any MappedBinaryGet(void *handle, int64_t index);
+UList MappedBinaryEntry(void *handle, int64_t index);
 bool StructuralEqual(AnyView lhs, AnyView rhs, bool bind_free_vars, bool assert_mode);
 int64_t StructuralHash(AnyView root);
+List<int64_t> StructuralHash128(AnyView root);
+List<int64_t> StructuralHashMany(UList roots);
+List<bool> StructuralEqualMany(UList pairs, bool bind_free_vars);
+void *HashConsNew();
+void HashConsDelete(void *table);
+int64_t HashConsSize(void *table);
+Any HashConsCanonicalize(void *table, AnyView source);
+Any HashConsIntern(void *table, AnyView source);
+void *StructuralHashMemoNew();
+void StructuralHashMemoDelete(void *memo);
+int64_t StructuralHashMemoSize(void *memo);
+int64_t StructuralHashMemoized(AnyView root, void *memo);
 Any CopyShallow(AnyView root);
 Any CopyDeep(AnyView root);
+Any Rewrite(AnyView root, Func fn);
 Str DocToPythonScript(mlc::printer::Node node, mlc::printer::PrinterConfig cfg);
 UDict BuildInfo();
+void ReclaimInBackground(bool enabled);
 
 Str TensorToBytes(const TensorObj *src);
 Str TensorToBase64(const TensorObj *src);
@@ -84,6 +113,10 @@ struct ResourcePool {
   void AddObj(void *ptr) {
     if (ptr != nullptr) {
       MLCAny *ptr_cast = reinterpret_cast<MLCAny *>(ptr);
+      if (this->immortal) {
+        ::mlc::base::MarkImmortal(ptr_cast);
+        return;
+      }
       ::mlc::base::IncRef(ptr_cast);
       this->objects.insert({ptr, ObjPtr(ptr_cast, ::mlc::base::DecRef)});
     }
@@ -91,8 +124,37 @@ struct ResourcePool {
 
   void DelObj(void *ptr) {
     if (ptr != nullptr) {
-      this->objects.erase(this->objects.find(ptr));
+      // Immortal objects are not tracked
+      if (auto it = this->objects.find(ptr); it != this->objects.end()) {
+        this->objects.erase(it);
+      }
+    }
+  }
+
+  /*!
+   * \brief Makes interned strings, now and in the future, immortal. Only meant for pools that are never
+   * destroyed, as interned strings are never dropped otherwise.
+   */
+  void MakeInternedImmortal() {
+    std::lock_guard<std::mutex> lock(this->interned_mutex);
+    this->immortal_interned = true;
+    for (auto &kv : this->interned) {
+      ::mlc::base::MarkImmortal(reinterpret_cast<MLCAny *>(kv.second.get()));
+    }
+  }
+
+  /*!
+   * \brief Makes all objects owned by the pool, now and in the future, immortal, so that they are never freed.
+   * Only meant for the shutdown of pools that are never destroyed, as objects dropped via `DelObj` afterwards
+   * are leaked.
+   */
+  void MakeImmortal() {
+    this->MakeInternedImmortal();
+    this->immortal = true;
+    for (auto &kv : this->objects) {
+      ::mlc::base::MarkImmortal(kv.second.get());
     }
+    this->objects.clear();
   }
 
   template <typename PODType> PODType *NewPODArray(int64_t size) {
@@ -115,6 +177,36 @@ struct ResourcePool {
     }
   }
 
+  StrObj *InternStr(AnyView source) {
+    std::string_view key;
+    if (source.type_index == kMLCRawStr) {
+      const char *data = source.operator const char *();
+      key = std::string_view(data, std::strlen(data));
+    } else if (source.type_index == kMLCSmallStr) {
+      key = std::string_view(source.v.v_bytes, source.small_len);
+    } else {
+      StrObj *src = source.operator StrObj *();
+      key = std::string_view(src->data(), src->size());
+    }
+    std::lock_guard<std::mutex> lock(this->interned_mutex);
+    auto it = this->interned.find(key);
+    if (it == this->interned.end()) {
+      // Interned strings are immortal map keys, so they are always copied onto the heap: the caller's object may be
+      // mutated later, or be owned by an arena it would then pin forever
+      ::mlc::base::ArenaState *arena = ::mlc::base::ArenaState::Current();
+      ::mlc::base::ArenaState::SetCurrent(nullptr);
+      StrObj *str = StrObj::Allocator::New(key.data(), key.size() + 1);
+      ::mlc::base::ArenaState::SetCurrent(arena);
+      Str canonical(str);
+      canonical->Hash();
+      if (this->immortal_interned) {
+        ::mlc::base::MarkImmortal(reinterpret_cast<MLCAny *>(str));
+      }
+      it = this->interned.emplace(canonical.ToStdStringView(), canonical).first;
+    }
+    return it->second.get();
+  }
+
 private:
   MLC_INLINE void *NewPODArrayImpl(int64_t size, size_t pod_size) {
     if (size == 0) {
@@ -132,6 +224,10 @@ private:
 
   std::unordered_map<const void *, ::mlc::base::PODArray> pod_array;
   std::unordered_multimap<const void *, ObjPtr> objects;
+  std::unordered_map<std::string_view, Str> interned;
+  std::mutex interned_mutex;
+  bool immortal = false;
+  bool immortal_interned = false;
 };
 
 struct TypeTable;
@@ -162,6 +258,7 @@ struct TypeInfoWrapper {
       this->pool->DelPODArray(this->info.type_ancestors);
       this->ResetFields();
       this->ResetMethods();
+      this->ResetPlans();
       this->info.type_key = nullptr;
       this->info.type_ancestors = nullptr;
       this->pool = nullptr;
@@ -204,6 +301,52 @@ struct TypeInfoWrapper {
     }
   }
 
+  void ResetPlans() {
+    for (MLCVisitOp **plan : {&this->info.field_plan, &this->info.ref_plan, &this->info.structure_plan}) {
+      if (*plan) {
+        this->pool->DelPODArray(*plan);
+        *plan = nullptr;
+      }
+    }
+  }
+
+  void CompilePlans() {
+    // Field types are decoded once per type here rather than once per visited object
+    this->ResetPlans();
+    if (this->num_fields == 0) {
+      return;
+    }
+    MLCTypeField *fields = this->info.fields;
+    MLCVisitOp *field_plan = this->info.field_plan = this->pool->NewPODArray<MLCVisitOp>(this->num_fields + 1);
+    MLCVisitOp *ref_plan = this->info.ref_plan = this->pool->NewPODArray<MLCVisitOp>(this->num_fields + 1);
+    for (int64_t i = 0; i < this->num_fields; ++i) {
+      MLCVisitOp op{::mlc::core::FieldVisitOpKind(&fields[i]), 0, fields[i].offset, &fields[i]};
+      *field_plan++ = op;
+      // Plain-old-data fields own no reference, so they are left out of the reference plan
+      if (op.kind <= kMLCVisitOptionalDevice || op.kind >= kMLCVisitUnsupportedPtr) {
+        *ref_plan++ = op;
+      }
+    }
+    *field_plan = MLCVisitOp{};
+    *ref_plan = MLCVisitOp{};
+    if (int32_t *indices = this->info.sub_structure_indices) {
+      int64_t num_sub_structures = 0;
+      for (; indices[num_sub_structures] != -1; ++num_sub_structures) {
+        if (indices[num_sub_structures] < 0 || indices[num_sub_structures] >= this->num_fields) {
+          return;
+        }
+      }
+      MLCVisitOp *structure_plan = this->info.structure_plan =
+          this->pool->NewPODArray<MLCVisitOp>(num_sub_structures + 1);
+      for (int64_t i = 0; i < num_sub_structures; ++i) {
+        MLCTypeField *field = &fields[indices[i]];
+        structure_plan[i] =
+            MLCVisitOp{::mlc::core::FieldVisitOpKind(field), this->info.sub_structure_kinds[i], field->offset, field};
+      }
+      structure_plan[num_sub_structures] = MLCVisitOp{};
+    }
+  }
+
   void SetFields(int64_t new_num_fields, MLCTypeField *fields) {
     this->ResetFields();
     this->num_fields = new_num_fields;
@@ -212,7 +355,7 @@ struct TypeInfoWrapper {
       MLCTypeField *dst = dsts + i;
       *dst = fields[i];
       this->pool->AddObj(dst->ty);
-      dst->name = this->pool->NewStr(dst->name);
+      dst->name = this->pool->InternStr(dst->name)->data();
       if (dst->index != i) {
         MLC_THROW(ValueError) << "Field index mismatch: " << i << " vs " << dst->index;
       }
@@ -220,6 +363,7 @@ struct TypeInfoWrapper {
     dsts[num_fields] = MLCTypeField{};
     std::sort(dsts, dsts + num_fields,
               [](const MLCTypeField &a, const MLCTypeField &b) { return a.offset < b.offset; });
+    this->CompilePlans();
   }
 
   void AddMethod(MLCTypeMethod method) {
@@ -260,6 +404,7 @@ struct TypeInfoWrapper {
       this->info.sub_structure_indices = nullptr;
       this->info.sub_structure_kinds = nullptr;
     }
+    this->CompilePlans();
   }
 };
 
@@ -468,8 +613,9 @@ struct TypeTable {
     MLCTypeInfo *parent = parent_type_index == -1 ? nullptr : this->GetTypeInfo(parent_type_index);
     MLCTypeInfo *info = &wrapper->info;
     info->type_index = type_index;
-    info->type_key = this->pool.NewStr(type_key);
-    info->type_key_hash = ::mlc::base::StrHash(type_key, std::strlen(type_key));
+    StrObj *interned_type_key = this->pool.InternStr(type_key);
+    info->type_key = interned_type_key->data();
+    info->type_key_hash = interned_type_key->Hash();
     info->type_depth = (parent == nullptr) ? 0 : (parent->type_depth + 1);
     info->type_ancestors = this->pool.NewPODArray<int32_t>(info->type_depth);
     if (parent) {
@@ -489,10 +635,12 @@ struct TypeTable {
     auto [it, success] = this->global_funcs.try_emplace(std::string(name), nullptr);
     if (!success && !allow_override) {
       MLC_THROW(KeyError) << "Global function already registered: " << name;
-    } else {
-      it->second = func;
     }
     this->pool.AddObj(func);
+    if (!success) {
+      this->pool.DelObj(it->second);
+    }
+    it->second = func;
   }
 
   TypeInfoWrapper *GetTypeInfoWrapper(int32_t type_index) {
@@ -643,14 +791,47 @@ inline TypeTable *TypeTable::New() {
   self->SetFunc("mlc.base.DataTypeFromStr", Func([self](const char *str) { return self->DataTypeFromStr(str); }).get());
   self->SetFunc("mlc.base.DeviceTypeRegister",
                 Func([self](const char *name) { return self->DeviceTypeRegister(name); }).get());
+  self->SetFunc("mlc.core.StrIntern", Func([self](AnyView source) { return Str(self->pool.InternStr(source)); }).get());
+  self->SetFunc("mlc.core.ArenaEnter", Func([]() -> void * { return new Arena(); }).get());
+  self->SetFunc("mlc.core.ArenaExit", Func([](void *handle) -> int64_t {
+                  std::unique_ptr<Arena> arena(static_cast<Arena *>(handle));
+                  return arena->Exit();
+                }).get());
   self->SetFunc("mlc.core.JSONLoads", Func(::mlc::registry::JSONLoads).get());
   self->SetFunc("mlc.core.JSONSerialize", Func(::mlc::registry::JSONSerialize).get());
   self->SetFunc("mlc.core.JSONDeserialize", Func(::mlc::registry::JSONDeserialize).get());
+  self->SetFunc("mlc.core.BinarySerialize", Func(::mlc::registry::BinarySerialize).get());
+  self->SetFunc("mlc.core.BinaryDeserialize", Func(::mlc::registry::BinaryDeserialize).get());
+  self->SetFunc("mlc.core.BinaryDeserializeBytes", Func(::mlc::registry::BinaryDeserializeBytes).get());
+  self->SetFunc("mlc.core.JSONSerializeTo", Func(::mlc::registry::JSONSerializeTo).get());
+  self->SetFunc("mlc.core.JSONDeserializeFrom", Func(::mlc::registry::JSONDeserializeFrom).get());
+  self->SetFunc("mlc.core.JSONDeserializeTensorFile", Func(::mlc::registry::JSONDeserializeTensorFile).get());
+  self->SetFunc("mlc.core.BinarySerializeTo", Func(::mlc::registry::BinarySerializeTo).get());
+  self->SetFunc("mlc.core.BinaryDeserializeFrom", Func(::mlc::registry::BinaryDeserializeFrom).get());
+  self->SetFunc("mlc.core.MappedBinaryOpen", Func(::mlc::registry::MappedBinaryOpen).get());
+  self->SetFunc("mlc.core.MappedBinaryDelete", Func(::mlc::registry::MappedBinaryDelete).get());
+  self->SetFunc("mlc.core.MappedBinarySize", Func(::mlc::registry::MappedBinarySize).get());
+  self->SetFunc("mlc.core.MappedBinaryGet", Func(::mlc::registry::MappedBinaryGet).get());
+  self->SetFunc("mlc.core.MappedBinaryEntry", Func(::mlc::registry::MappedBinaryEntry).get());
   self->SetFunc("mlc.core.StructuralEqual", Func(::mlc::registry::StructuralEqual).get());
   self->SetFunc("mlc.core.StructuralHash", Func(::mlc::registry::StructuralHash).get());
+  self->SetFunc("mlc.core.StructuralHash128", Func(::mlc::registry::StructuralHash128).get());
+  self->SetFunc("mlc.core.StructuralHashMany", Func(::mlc::registry::StructuralHashMany).get());
+  self->SetFunc("mlc.core.StructuralEqualMany", Func(::mlc::registry::StructuralEqualMany).get());
+  self->SetFunc("mlc.core.StructuralHashMemoNew", Func(::mlc::registry::StructuralHashMemoNew).get());
+  self->SetFunc("mlc.core.StructuralHashMemoDelete", Func(::mlc::registry::StructuralHashMemoDelete).get());
+  self->SetFunc("mlc.core.StructuralHashMemoSize", Func(::mlc::registry::StructuralHashMemoSize).get());
+  self->SetFunc("mlc.core.StructuralHashMemoized", Func(::mlc::registry::StructuralHashMemoized).get());
+  self->SetFunc("mlc.core.HashConsNew", Func(::mlc::registry::HashConsNew).get());
+  self->SetFunc("mlc.core.HashConsDelete", Func(::mlc::registry::HashConsDelete).get());
+  self->SetFunc("mlc.core.HashConsSize", Func(::mlc::registry::HashConsSize).get());
+  self->SetFunc("mlc.core.HashConsCanonicalize", Func(::mlc::registry::HashConsCanonicalize).get());
+  self->SetFunc("mlc.core.HashConsIntern", Func(::mlc::registry::HashConsIntern).get());
   self->SetFunc("mlc.core.CopyShallow", Func(::mlc::registry::CopyShallow).get());
   self->SetFunc("mlc.core.CopyDeep", Func(::mlc::registry::CopyDeep).get());
+  self->SetFunc("mlc.core.Rewrite", Func(::mlc::registry::Rewrite).get());
   self->SetFunc("mlc.core.BuildInfo", Func(::mlc::registry::BuildInfo).get());
+  self->SetFunc("mlc.core.ReclaimInBackground", Func(::mlc::registry::ReclaimInBackground).get());
   self->SetFunc("mlc.core.TensorToBytes", Func(::mlc::registry::TensorToBytes).get());
   self->SetFunc("mlc.core.TensorFromBytes", Func(::mlc::registry::TensorFromBytes).get());
   self->SetFunc("mlc.core.TensorToBase64", Func(::mlc::registry::TensorToBase64).get());
@@ -709,6 +890,18 @@ inline TypeTable *TypeTable::New() {
   method_member("__str__", &TypeTraits<const char *>::__str__);
   MLC_TYPE_TABLE_INIT_TYPE_END()
 
+  {
+    // Small strings are stored inline in `MLCAny` and have no dedicated C++ type
+    int32_t type_index = static_cast<int32_t>(MLCTypeIndex::kMLCSmallStr);
+    self->TypeRegister(-1, type_index, "str");
+    Func str = Func([](AnyView self) {
+      std::ostringstream os;
+      StrObj::PrintEscape(self.v.v_bytes, self.small_len, os);
+      return os.str();
+    });
+    self->AddMethod(type_index, MLCTypeMethod{"__str__", reinterpret_cast<MLCFunc *>(str.get()), 0});
+  }
+
   return self;
 }
 #undef MLC_TYPE_TABLE_INIT_TYPE_BEGIN
@@ -1,275 +1,512 @@
 #include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <mlc/core/all.h>
+#include <mutex>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
+#include <sys/stat.h>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MLC_JSON_SCAN_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MLC_JSON_SCAN_NEON 1
+#endif
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define MLC_BASE64_X86 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MLC_TARGET(isa)
+#else
+#define MLC_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+#ifdef _MSC_VER
+#include <io.h>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 namespace mlc {
 namespace {
 
 using mlc::core::ObjectPath;
 using mlc::core::TopoVisit;
+using mlc::core::VisitFieldRefs;
 using mlc::core::VisitFields;
 using mlc::core::VisitStructure;
 
 /****************** JSON ******************/
 
-inline Any JSONLoads(const char *json_str, int64_t json_str_len) {
-  struct JSONParser {
-    Any Parse() {
-      SkipWhitespace();
-      Any result = ParseValue();
-      SkipWhitespace();
-      if (i != json_str_len) {
-        MLC_THROW(ValueError) << "JSON parsing failure at position " << i
-                              << ": Extra data after valid JSON. JSON string: " << json_str;
+/*!
+ * \brief Bitmasks of the double quotes and backslashes in a 64-byte block, where bit `j` stands for byte `j`.
+ */
+struct JSONBlockMasks {
+  uint64_t quote;
+  uint64_t backslash;
+};
+
+MLC_INLINE JSONBlockMasks JSONScanBlock(const char *block) {
+  JSONBlockMasks ret{0, 0};
+#if defined(MLC_JSON_SCAN_SSE2)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  for (int32_t j = 0; j < 64; j += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + j));
+    uint32_t q = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)));
+    uint32_t b = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)));
+    ret.quote |= static_cast<uint64_t>(q) << j;
+    ret.backslash |= static_cast<uint64_t>(b) << j;
+  }
+#elif defined(MLC_JSON_SCAN_NEON)
+  // NEON has no movemask: weight each matching lane by its bit and sum the halves
+  static constexpr uint8_t kBits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  const uint8x16_t bits = vld1q_u8(kBits);
+  auto to_mask = [&bits](uint8x16_t hit) -> uint64_t {
+    uint8x16_t weighted = vandq_u8(hit, bits);
+    return static_cast<uint64_t>(vaddv_u8(vget_low_u8(weighted))) |
+           (static_cast<uint64_t>(vaddv_u8(vget_high_u8(weighted))) << 8);
+  };
+  for (int32_t j = 0; j < 64; j += 16) {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(block + j));
+    ret.quote |= to_mask(vceqq_u8(chunk, vdupq_n_u8('"'))) << j;
+    ret.backslash |= to_mask(vceqq_u8(chunk, vdupq_n_u8('\\'))) << j;
+  }
+#else
+  for (int32_t j = 0; j < 64; ++j) {
+    ret.quote |= static_cast<uint64_t>(block[j] == '"') << j;
+    ret.backslash |= static_cast<uint64_t>(block[j] == '\\') << j;
+  }
+#endif
+  return ret;
+}
+
+/*!
+ * \brief Positions of the double quotes that are not escaped by a backslash, which bound the strings of a JSON
+ * document in pairs. Bytes are classified 64 at a time, and only backslashes are then visited one by one.
+ */
+inline std::vector<int64_t> JSONIndexQuotes(const char *json_str, int64_t json_str_len) {
+  std::vector<int64_t> quotes;
+  bool carry = false; // whether the first byte of the next block is escaped
+  char tail[64];
+  for (int64_t base = 0; base < json_str_len; base += 64) {
+    const char *block = json_str + base;
+    if (json_str_len - base < 64) {
+      std::memset(tail, ' ', sizeof(tail));
+      std::memcpy(tail, block, static_cast<size_t>(json_str_len - base));
+      block = tail;
+    }
+    JSONBlockMasks masks = JSONScanBlock(block);
+    uint64_t escaped = carry ? 1 : 0;
+    carry = false;
+    for (uint64_t bs = masks.backslash & ~escaped; bs != 0;) {
+      int32_t j = ::mlc::base::CountTrailingZeros(bs);
+      if (j == 63) {
+        carry = true;
+        break;
       }
-      return result;
+      // The next byte is escaped; if it is a backslash itself, it escapes nothing
+      escaped |= uint64_t(1) << (j + 1);
+      bs &= ~((uint64_t(2) << (j + 1)) - 1);
+    }
+    for (uint64_t q = masks.quote & ~escaped; q != 0; q &= q - 1) {
+      quotes.push_back(base + ::mlc::base::CountTrailingZeros(q));
     }
+  }
+  return quotes;
+}
 
-    void ExpectChar(char c) {
-      if (json_str[i] == c) {
-        ++i;
-      } else {
-        MLC_THROW(ValueError) << "JSON parsing failure at position " << i << ": Expected '" << c << "' but got '"
-                              << json_str[i] << "'. JSON string: " << json_str;
-      }
+/*!
+ * \brief A recursive-descent JSON parser. Strings are bounded using the quote index built by `Parse`, or by
+ * `Index` for callers that drive the parser themselves.
+ */
+struct JSONParser {
+  Any Parse() {
+    Index();
+    SkipWhitespace();
+    Any result = ParseValue();
+    SkipWhitespace();
+    if (i != json_str_len) {
+      MLC_THROW(ValueError) << "JSON parsing failure at position " << i
+                            << ": Extra data after valid JSON. JSON string: " << json_str;
+    }
+    return result;
+  }
+
+  void Index() {
+    quotes = JSONIndexQuotes(json_str, json_str_len);
+    next_quote = 0;
+  }
+
+  /*! \brief Moves to position `pos`, which must not be inside a string. */
+  void Seek(int64_t pos) {
+    i = pos;
+    next_quote = static_cast<size_t>(std::lower_bound(quotes.begin(), quotes.end(), pos) - quotes.begin());
+  }
+
+  void ExpectChar(char c) {
+    if (json_str[i] == c) {
+      ++i;
+    } else {
+      MLC_THROW(ValueError) << "JSON parsing failure at position " << i << ": Expected '" << c << "' but got '"
+                            << json_str[i] << "'. JSON string: " << json_str;
     }
+  }
 
-    char PeekChar() { return i < json_str_len ? json_str[i] : '\0'; }
+  char PeekChar() { return i < json_str_len ? json_str[i] : '\0'; }
 
-    void SkipWhitespace() {
-      while (i < json_str_len && std::isspace(json_str[i])) {
-        ++i;
-      }
+  static bool IsSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+  void SkipWhitespace() {
+    while (i < json_str_len && IsSpace(json_str[i])) {
+      ++i;
     }
+  }
 
-    void ExpectString(const char *expected, int64_t len) {
-      if (i + len <= json_str_len && std::strncmp(json_str + i, expected, len) == 0) {
-        i = i + len;
-      } else {
-        MLC_THROW(ValueError) << "JSON parsing failure at position " << i << ": Expected '" << expected
-                              << ". JSON string: " << json_str;
-      }
+  void ExpectString(const char *expected, int64_t len) {
+    if (i + len <= json_str_len && std::strncmp(json_str + i, expected, len) == 0) {
+      i = i + len;
+    } else {
+      MLC_THROW(ValueError) << "JSON parsing failure at position " << i << ": Expected '" << expected
+                            << ". JSON string: " << json_str;
     }
+  }
+
+  Any ParseNull() {
+    ExpectString("null", 4);
+    return Any(nullptr);
+  }
 
-    Any ParseNull() {
-      ExpectString("null", 4);
-      return Any(nullptr);
+  Any ParseBoolean() {
+    if (PeekChar() == 't') {
+      ExpectString("true", 4);
+      return Any(true);
+    } else {
+      ExpectString("false", 5);
+      return Any(false);
     }
+  }
 
-    Any ParseBoolean() {
-      if (PeekChar() == 't') {
-        ExpectString("true", 4);
-        return Any(true);
+  Any ParseNumber() {
+    int64_t start = i;
+    // Identify the end of the numeric sequence
+    while (i < json_str_len) {
+      char c = json_str[i];
+      if (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-' || std::isdigit(c)) {
+        ++i;
       } else {
-        ExpectString("false", 5);
-        return Any(false);
+        break;
       }
     }
-
-    Any ParseNumber() {
-      int64_t start = i;
-      // Identify the end of the numeric sequence
-      while (i < json_str_len) {
-        char c = json_str[i];
-        if (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-' || std::isdigit(c)) {
-          ++i;
-        } else {
-          break;
-        }
+    // Fast path: decimal integers short enough not to overflow `int64_t`
+    int64_t digits_begin = json_str[start] == '-' ? start + 1 : start;
+    if (i > digits_begin && i - digits_begin <= 18) {
+      int64_t value = 0;
+      int64_t j = digits_begin;
+      for (; j < i && std::isdigit(json_str[j]); ++j) {
+        value = value * 10 + (json_str[j] - '0');
       }
-      std::string num_str(json_str + start, i - start);
-      std::size_t pos = 0;
-      try {
-        // Attempt to parse as integer
-        int64_t int_value = std::stoll(num_str, &pos);
-        if (pos == num_str.size()) {
-          i = start + static_cast<int64_t>(pos); // Update the main index
-          return Any(int_value);
-        }
-      } catch (const std::invalid_argument &) { // Not an integer, proceed to parse as double
-      } catch (const std::out_of_range &) {     // Integer out of range, proceed to parse as double
+      if (j == i) {
+        return Any(digits_begin == start ? value : -value);
       }
-      try {
-        // Attempt to parse as double
-        double double_value = std::stod(num_str, &pos);
-        if (pos == num_str.size()) {
-          i = start + pos; // Update the main index
-          return Any(double_value);
-        }
-      } catch (const std::invalid_argument &) {
-      } catch (const std::out_of_range &) {
+    }
+    std::string num_str(json_str + start, i - start);
+    std::size_t pos = 0;
+    try {
+      // Attempt to parse as integer
+      int64_t int_value = std::stoll(num_str, &pos);
+      if (pos == num_str.size()) {
+        i = start + static_cast<int64_t>(pos); // Update the main index
+        return Any(int_value);
       }
-      MLC_THROW(ValueError) << "JSON parsing failure at position " << i
-                            << ": Invalid number format. JSON string: " << json_str;
-      MLC_UNREACHABLE();
+    } catch (const std::invalid_argument &) { // Not an integer, proceed to parse as double
+    } catch (const std::out_of_range &) {     // Integer out of range, proceed to parse as double
+    }
+    try {
+      // Attempt to parse as double
+      double double_value = std::stod(num_str, &pos);
+      if (pos == num_str.size()) {
+        i = start + pos; // Update the main index
+        return Any(double_value);
+      }
+    } catch (const std::invalid_argument &) {
+    } catch (const std::out_of_range &) {
     }
+    MLC_THROW(ValueError) << "JSON parsing failure at position " << i
+                          << ": Invalid number format. JSON string: " << json_str;
+    MLC_UNREACHABLE();
+  }
 
-    Any ParseStr() {
-      ExpectChar('"');
-      std::ostringstream oss;
-      while (true) {
+  Any ParseStr() {
+    std::string decoded;
+    std::string_view str = ScanStr(&decoded);
+    if (str.data() == decoded.data()) {
+      return Any(Str(std::move(decoded)));
+    }
+    return Any(Str(::mlc::base::StrCopyFromCharArray(str.data(), str.size())));
+  }
+
+  /*!
+   * \brief Consumes a string, and returns its content in place if it has no escape sequences, or decoded into
+   * `decoded` otherwise, replacing what it held before. The closing quote is the next entry of the quote index, as
+   * every quote before it was consumed by an earlier string.
+   */
+  std::string_view ScanStr(std::string *decoded) {
+    ExpectChar('"');
+    int64_t begin = i;
+    int64_t end = json_str_len;
+    while (next_quote < quotes.size() && quotes[next_quote] < begin) {
+      ++next_quote;
+    }
+    if (next_quote < quotes.size()) {
+      end = quotes[next_quote++];
+    }
+    if (end < json_str_len && std::memchr(json_str + begin, '\\', static_cast<size_t>(end - begin)) == nullptr) {
+      i = end + 1;
+      return std::string_view(json_str + begin, static_cast<size_t>(end - begin));
+    }
+    std::string &oss = *decoded;
+    oss.clear();
+    oss.reserve(static_cast<size_t>(end - begin));
+    while (true) {
+      if (i >= json_str_len) {
+        MLC_THROW(ValueError) << "JSON parsing failure at position " << i
+                              << ": Unterminated string. JSON string: " << json_str;
+      }
+      // Copy the run of regular characters up to the next escape sequence or the closing quote
+      int64_t run_end = i;
+      while (run_end < end && json_str[run_end] != '\\') {
+        ++run_end;
+      }
+      oss.append(json_str + i, static_cast<size_t>(run_end - i));
+      i = run_end;
+      if (i >= json_str_len) {
+        continue;
+      }
+      char c = json_str[i++];
+      if (c == '"') {
+        // End of string
+        return std::string_view(oss);
+      } else if (c == '\\') {
+        // Handle escape sequences
         if (i >= json_str_len) {
           MLC_THROW(ValueError) << "JSON parsing failure at position " << i
-                                << ": Unterminated string. JSON string: " << json_str;
+                                << ": Incomplete escape sequence. JSON string: " << json_str;
         }
-        char c = json_str[i++];
-        if (c == '"') {
-          // End of string
-          return Any(Str(oss.str()));
-        } else if (c == '\\') {
-          // Handle escape sequences
-          if (i >= json_str_len) {
-            MLC_THROW(ValueError) << "JSON parsing failure at position " << i
-                                  << ": Incomplete escape sequence. JSON string: " << json_str;
-          }
-          char next = json_str[i++];
-          switch (next) {
-          case 'n':
-            oss << '\n';
-            break;
-          case 't':
-            oss << '\t';
-            break;
-          case 'r':
-            oss << '\r';
-            break;
-          case '\\':
-            oss << '\\';
-            break;
-          case '"':
-            oss << '\"';
-            break;
-          case 'x': {
-            if (i + 1 < json_str_len && std::isxdigit(json_str[i]) && std::isxdigit(json_str[i + 1])) {
-              int32_t value = std::stoi(std::string(json_str + i, 2), nullptr, 16);
-              oss << static_cast<char>(value);
-              i += 2;
-            } else {
-              MLC_THROW(ValueError) << "Invalid hexadecimal escape sequence at position " << i - 2
-                                    << " in string: " << json_str;
-            }
-            break;
+        char next = json_str[i++];
+        switch (next) {
+        case 'n':
+          oss += '\n';
+          break;
+        case 't':
+          oss += '\t';
+          break;
+        case 'r':
+          oss += '\r';
+          break;
+        case '\\':
+          oss += '\\';
+          break;
+        case '"':
+          oss += '\"';
+          break;
+        case 'x': {
+          if (i + 1 < json_str_len && std::isxdigit(json_str[i]) && std::isxdigit(json_str[i + 1])) {
+            int32_t value = std::stoi(std::string(json_str + i, 2), nullptr, 16);
+            oss += static_cast<char>(value);
+            i += 2;
+          } else {
+            MLC_THROW(ValueError) << "Invalid hexadecimal escape sequence at position " << i - 2
+                                  << " in string: " << json_str;
           }
-          case 'u': {
-            if (i + 3 < json_str_len && std::isxdigit(json_str[i]) && std::isxdigit(json_str[i + 1]) &&
-                std::isxdigit(json_str[i + 2]) && std::isxdigit(json_str[i + 3])) {
-              int32_t codepoint = std::stoi(std::string(json_str + i, 4), nullptr, 16);
-              if (codepoint <= 0x7F) {
-                // 1-byte UTF-8
-                oss << static_cast<char>(codepoint);
-              } else if (codepoint <= 0x7FF) {
-                // 2-byte UTF-8
-                oss << static_cast<char>(0xC0 | (codepoint >> 6));
-                oss << static_cast<char>(0x80 | (codepoint & 0x3F));
-              } else {
-                // 3-byte UTF-8
-                oss << static_cast<char>(0xE0 | (codepoint >> 12));
-                oss << static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-                oss << static_cast<char>(0x80 | (codepoint & 0x3F));
-              }
-              i += 4;
+          break;
+        }
+        case 'u': {
+          if (i + 3 < json_str_len && std::isxdigit(json_str[i]) && std::isxdigit(json_str[i + 1]) &&
+              std::isxdigit(json_str[i + 2]) && std::isxdigit(json_str[i + 3])) {
+            int32_t codepoint = std::stoi(std::string(json_str + i, 4), nullptr, 16);
+            if (codepoint <= 0x7F) {
+              // 1-byte UTF-8
+              oss += static_cast<char>(codepoint);
+            } else if (codepoint <= 0x7FF) {
+              // 2-byte UTF-8
+              oss += static_cast<char>(0xC0 | (codepoint >> 6));
+              oss += static_cast<char>(0x80 | (codepoint & 0x3F));
             } else {
-              MLC_THROW(ValueError) << "Invalid Unicode escape sequence at position " << i - 2
-                                    << " in string: " << json_str;
+              // 3-byte UTF-8
+              oss += static_cast<char>(0xE0 | (codepoint >> 12));
+              oss += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+              oss += static_cast<char>(0x80 | (codepoint & 0x3F));
             }
-            break;
-          }
-          default:
-            // Unrecognized escape sequence, interpret literally
-            oss << next;
-            break;
+            i += 4;
+          } else {
+            MLC_THROW(ValueError) << "Invalid Unicode escape sequence at position " << i - 2
+                                  << " in string: " << json_str;
           }
-        } else {
-          // Regular character, copy as-is
-          oss << c;
+          break;
+        }
+        default:
+          // Unrecognized escape sequence, interpret literally
+          oss += next;
+          break;
         }
       }
     }
+  }
 
-    UList ParseArray() {
-      UList arr;
-      ExpectChar('[');
+  UList ParseArray() {
+    UList arr;
+    ExpectChar('[');
+    SkipWhitespace();
+    if (PeekChar() == ']') {
+      ExpectChar(']');
+      return arr;
+    }
+    while (true) {
+      SkipWhitespace();
+      arr.push_back(ParseValue());
       SkipWhitespace();
       if (PeekChar() == ']') {
         ExpectChar(']');
         return arr;
       }
-      while (true) {
-        SkipWhitespace();
-        arr.push_back(ParseValue());
-        SkipWhitespace();
-        if (PeekChar() == ']') {
-          ExpectChar(']');
-          return arr;
-        }
-        ExpectChar(',');
-      }
+      ExpectChar(',');
     }
+  }
 
-    Any ParseObject() {
-      UDict obj;
-      ExpectChar('{');
+  Any ParseObject() {
+    UDict obj;
+    ExpectChar('{');
+    SkipWhitespace();
+    if (PeekChar() == '}') {
+      ExpectChar('}');
+      return Any(obj);
+    }
+    while (true) {
+      SkipWhitespace();
+      Any key = ParseKey();
+      SkipWhitespace();
+      ExpectChar(':');
+      SkipWhitespace();
+      Any value = ParseValue();
+      obj[key] = value;
       SkipWhitespace();
       if (PeekChar() == '}') {
         ExpectChar('}');
         return Any(obj);
       }
+      ExpectChar(',');
+    }
+  }
+
+  Any ParseKey() {
+    // Object keys repeat across objects, so each distinct key is backed by a single `Str`,
+    // which hashes once and compares by pointer in later dict operations.
+    std::string decoded;
+    std::string_view str = ScanStr(&decoded);
+    if (auto it = keys.find(str); it != keys.end()) {
+      return it->second;
+    }
+    Str key(::mlc::base::StrCopyFromCharArray(str.data(), str.size()));
+    return keys.emplace(key.ToStdStringView(), key).first->second;
+  }
+
+  /*! \brief Consumes a value without constructing it, apart from its numbers. */
+  void SkipValue() {
+    SkipWhitespace();
+    char c = PeekChar();
+    std::string decoded;
+    if (c == '"') {
+      ScanStr(&decoded);
+    } else if (c == '[' || c == '{') {
+      char close = c == '[' ? ']' : '}';
+      ExpectChar(c);
+      SkipWhitespace();
+      if (PeekChar() == close) {
+        ExpectChar(close);
+        return;
+      }
       while (true) {
         SkipWhitespace();
-        Any key = ParseStr();
-        SkipWhitespace();
-        ExpectChar(':');
-        SkipWhitespace();
-        Any value = ParseValue();
-        obj[key] = value;
+        if (close == '}') {
+          ScanStr(&decoded);
+          SkipWhitespace();
+          ExpectChar(':');
+        }
+        SkipValue();
         SkipWhitespace();
-        if (PeekChar() == '}') {
-          ExpectChar('}');
-          return Any(obj);
+        if (PeekChar() == close) {
+          ExpectChar(close);
+          return;
         }
         ExpectChar(',');
       }
+    } else {
+      ParseValue();
     }
+  }
 
-    Any ParseValue() {
-      SkipWhitespace();
-      char c = PeekChar();
-      if (c == '"') {
-        return ParseStr();
-      } else if (c == '{') {
-        return ParseObject();
-      } else if (c == '[') {
-        return ParseArray();
-      } else if (c == 'n') {
-        return ParseNull();
-      } else if (c == 't' || c == 'f') {
-        return ParseBoolean();
-      } else if (std::isdigit(c) || c == '-') {
-        return ParseNumber();
-      } else {
-        MLC_THROW(ValueError) << "JSON parsing failure at position " << i << ": Unexpected character: " << c
-                              << ". JSON string: " << json_str;
-      }
-      MLC_UNREACHABLE();
+  Any ParseValue() {
+    SkipWhitespace();
+    char c = PeekChar();
+    if (c == '"') {
+      return ParseStr();
+    } else if (c == '{') {
+      return ParseObject();
+    } else if (c == '[') {
+      return ParseArray();
+    } else if (c == 'n') {
+      return ParseNull();
+    } else if (c == 't' || c == 'f') {
+      return ParseBoolean();
+    } else if (std::isdigit(c) || c == '-') {
+      return ParseNumber();
+    } else {
+      MLC_THROW(ValueError) << "JSON parsing failure at position " << i << ": Unexpected character: " << c
+                            << ". JSON string: " << json_str;
     }
-    int64_t i;
-    int64_t json_str_len;
-    const char *json_str;
-  };
+    MLC_UNREACHABLE();
+  }
+  int64_t i;
+  int64_t json_str_len;
+  const char *json_str;
+  std::unordered_map<std::string_view, Str> keys;
+  std::vector<int64_t> quotes;
+  size_t next_quote;
+};
+
+inline Any JSONLoads(const char *json_str, int64_t json_str_len) {
   if (json_str_len < 0) {
     json_str_len = static_cast<int64_t>(std::strlen(json_str));
   }
-  return JSONParser{0, json_str_len, json_str}.Parse();
+  return JSONParser{0, json_str_len, json_str, {}, {}, 0}.Parse();
 }
 
 /****************** Base64 Encoding/Decoding ******************/
@@ -287,40 +524,241 @@ static const std::array<uint8_t, 256> kBase64DecTable = []() {
   return ret;
 }();
 
+#if MLC_BASE64_X86
+// The SIMD kernels below follow "Faster Base64 Encoding and Decoding Using AVX2 Instructions" by Muła and Lemire.
+// They are compiled for their instruction set regardless of the build flags, and picked at runtime.
+enum class Base64ISA : int32_t { kScalar = 0, kSSSE3 = 1, kAVX2 = 2 };
+
+inline Base64ISA Base64DetectISA() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  int max_leaf = info[0];
+  __cpuid(info, 1);
+  bool ssse3 = (info[2] & (1 << 9)) != 0;
+  bool os_avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+  bool avx2 = false;
+  if (max_leaf >= 7 && os_avx) {
+    __cpuidex(info, 7, 0);
+    avx2 = (info[1] & (1 << 5)) != 0;
+  }
+#else
+  __builtin_cpu_init();
+  bool ssse3 = __builtin_cpu_supports("ssse3");
+  bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+  return avx2 ? Base64ISA::kAVX2 : ssse3 ? Base64ISA::kSSSE3 : Base64ISA::kScalar;
+}
+
+inline Base64ISA Base64GetISA() {
+  static const Base64ISA isa = Base64DetectISA();
+  return isa;
+}
+
+/*! \brief Spreads 12 bytes, 3 in each 32-bit lane, into 16 6-bit indices and maps them to the alphabet. */
+MLC_TARGET("ssse3") inline __m128i Base64EncodeBlock(__m128i in) {
+  const __m128i lut = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+  in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+  __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+  __m128i indices = _mm_or_si128(t0, t1);
+  // 0..25 => 0, 26..51 => 1, 52..61 => 2..11, 62 => 12, 63 => 13, each selecting the offset to its character
+  __m128i range = _mm_sub_epi8(_mm_subs_epu8(indices, _mm_set1_epi8(51)), _mm_cmpgt_epi8(indices, _mm_set1_epi8(25)));
+  return _mm_add_epi8(indices, _mm_shuffle_epi8(lut, range));
+}
+
+MLC_TARGET("avx2") inline __m256i Base64EncodeBlock(__m256i in) {
+  const __m256i lut = _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0, //
+                                       65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+  in = _mm256_shuffle_epi8(in, _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1, //
+                                               10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+  __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+  __m256i indices = _mm256_or_si256(t0, t1);
+  __m256i range =
+      _mm256_sub_epi8(_mm256_subs_epu8(indices, _mm256_set1_epi8(51)), _mm256_cmpgt_epi8(indices, _mm256_set1_epi8(25)));
+  return _mm256_add_epi8(indices, _mm256_shuffle_epi8(lut, range));
+}
+
+/*!
+ * \brief Maps 16 characters to their 6-bit values and packs them into 12 bytes, at the front of the register.
+ * Returns false if any character is outside of the alphabet, padding included.
+ */
+MLC_TARGET("ssse3") inline bool Base64DecodeBlock(__m128i str, __m128i *out) {
+  const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B,
+                                       0x1B, 0x1B, 0x1A);
+  const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                       0x10, 0x10, 0x10);
+  const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i mask_2f = _mm_set1_epi8(0x2f);
+  __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(str, 4), mask_2f);
+  __m128i lo = _mm_shuffle_epi8(lut_lo, _mm_and_si128(str, mask_2f));
+  __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xFFFF) {
+    return false;
+  }
+  __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(str, mask_2f), hi_nibbles));
+  str = _mm_add_epi8(str, roll);
+  __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(str, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+  *out = _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+  return true;
+}
+
+MLC_TARGET("avx2") inline bool Base64DecodeBlock(__m256i str, __m256i *out) {
+  const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A,
+                                          0x1B, 0x1B, 0x1B, 0x1A, //
+                                          0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A,
+                                          0x1B, 0x1B, 0x1B, 0x1A);
+  const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+                                          0x10, 0x10, 0x10, 0x10, //
+                                          0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+                                          0x10, 0x10, 0x10, 0x10);
+  const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, //
+                                            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i mask_2f = _mm256_set1_epi8(0x2f);
+  __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), mask_2f);
+  __m256i lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(str, mask_2f));
+  __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+  if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256())) != -1) {
+    return false;
+  }
+  __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(str, mask_2f), hi_nibbles));
+  str = _mm256_add_epi8(str, roll);
+  __m256i merged =
+      _mm256_madd_epi16(_mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+  *out = _mm256_shuffle_epi8(merged, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, //
+                                                      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+  return true;
+}
+
+/*! \brief Encodes 12 bytes at a time, for as long as 16 bytes can be loaded, returning the number encoded. */
+MLC_TARGET("ssse3") inline int64_t Base64EncodeSSSE3(const uint8_t *data, int64_t len, uint8_t *out) {
+  int64_t i = 0;
+  for (; i + 16 <= len; i += 12, out += 16) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), Base64EncodeBlock(in));
+  }
+  return i;
+}
+
+/*! \brief Encodes 24 bytes at a time, 12 in each 128-bit lane. */
+MLC_TARGET("avx2") inline int64_t Base64EncodeAVX2(const uint8_t *data, int64_t len, uint8_t *out) {
+  int64_t i = 0;
+  for (; i + 28 <= len; i += 24, out += 32) {
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 12));
+    __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), Base64EncodeBlock(in));
+  }
+  return i;
+}
+
+/*!
+ * \brief Decodes 16 characters at a time, stopping at the first block with a character outside of the alphabet,
+ * and returns the number of characters decoded. Each store writes 4 bytes past the decoded ones, which is why the
+ * last 8 characters are always left to the caller.
+ */
+MLC_TARGET("ssse3") inline int64_t Base64DecodeSSSE3(const uint8_t *data, int64_t len, uint8_t *out) {
+  int64_t i = 0;
+  __m128i block;
+  for (; i + 24 <= len; i += 16, out += 12) {
+    if (!Base64DecodeBlock(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)), &block)) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), block);
+  }
+  return i;
+}
+
+MLC_TARGET("avx2") inline int64_t Base64DecodeAVX2(const uint8_t *data, int64_t len, uint8_t *out) {
+  int64_t i = 0;
+  __m256i block;
+  for (; i + 48 <= len; i += 32, out += 24) {
+    if (!Base64DecodeBlock(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)), &block)) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm256_castsi256_si128(block));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 12), _mm256_extracti128_si256(block, 1));
+  }
+  return i;
+}
+#endif
+
+/*! \brief Encodes the longest prefix of `len` bytes it can with SIMD, returning its length, a multiple of 3. */
+inline int64_t Base64EncodeSIMD(const uint8_t *data, int64_t len, uint8_t *out) {
+  int64_t i = 0;
+#if MLC_BASE64_X86
+  Base64ISA isa = Base64GetISA();
+  if (isa == Base64ISA::kAVX2) {
+    i = Base64EncodeAVX2(data, len, out);
+  }
+  if (isa >= Base64ISA::kSSSE3) {
+    i += Base64EncodeSSSE3(data + i, len - i, out + i / 3 * 4);
+  }
+#else
+  (void)data;
+  (void)len;
+  (void)out;
+#endif
+  return i;
+}
+
+/*! \brief Decodes the longest prefix of `len` characters it can with SIMD, returning its length, a multiple of 4. */
+inline int64_t Base64DecodeSIMD(const uint8_t *data, int64_t len, uint8_t *out) {
+  int64_t i = 0;
+#if MLC_BASE64_X86
+  Base64ISA isa = Base64GetISA();
+  if (isa == Base64ISA::kAVX2) {
+    i = Base64DecodeAVX2(data, len, out);
+  }
+  if (isa >= Base64ISA::kSSSE3) {
+    i += Base64DecodeSSSE3(data + i, len - i, out + i / 4 * 3);
+  }
+#else
+  (void)data;
+  (void)len;
+  (void)out;
+#endif
+  return i;
+}
+
+/*! \brief Encodes `len` bytes, a multiple of 3, into `len / 3 * 4` characters. */
+inline void Base64EncodeGroups(const uint8_t *data, int64_t len, uint8_t *out) {
+  int64_t simd_len = Base64EncodeSIMD(data, len, out);
+  data += simd_len;
+  len -= simd_len;
+  out += simd_len / 3 * 4;
+  for (int64_t i = 0; i < len; i += 3, out += 4) {
+    uint32_t chunk = (static_cast<uint32_t>(data[i]) << 16) | (static_cast<uint32_t>(data[i + 1]) << 8) | data[i + 2];
+    out[0] = kBase64EncTable[(chunk >> 18) & 0x3F];
+    out[1] = kBase64EncTable[(chunk >> 12) & 0x3F];
+    out[2] = kBase64EncTable[(chunk >> 6) & 0x3F];
+    out[3] = kBase64EncTable[chunk & 0x3F];
+  }
+}
+
+/*! \brief Encodes the last 1 or 2 bytes of an input into 4 characters padded with '='. */
+inline void Base64EncodeTail(const uint8_t *data, int64_t len, uint8_t *out) {
+  uint32_t chunk = static_cast<uint32_t>(data[0]) << 16;
+  if (len > 1) {
+    chunk |= static_cast<uint32_t>(data[1]) << 8;
+  }
+  out[0] = kBase64EncTable[(chunk >> 18) & 0x3F];
+  out[1] = kBase64EncTable[(chunk >> 12) & 0x3F];
+  out[2] = len > 1 ? kBase64EncTable[(chunk >> 6) & 0x3F] : '=';
+  out[3] = '=';
+}
+
 Str Base64Encode(const uint8_t *data, int64_t len) {
-  constexpr int BITS_PER_CHAR = 6;
   Str ret(::mlc::core::StrPad::Allocator::NewWithPad<uint8_t>(((len + 2) / 3) * 4 + 1, 0));
   uint8_t *out = reinterpret_cast<uint8_t *>(ret.get()->::MLCStr::data);
   int64_t &out_len = ret.get()->::MLCStr::length;
-  for (int64_t i = 0; i < len; i += 3) {
-    // Collect up to 3 bytes into a 24-bit chunk
-    uint32_t chunk = 0;
-    int bytes_in_chunk = 0;
-    for (int j = 0; j < 3; ++j) {
-      if (i + j < len) {
-        chunk <<= 8;
-        chunk |= data[i + j];
-        bytes_in_chunk++;
-      } else {
-        chunk <<= 8; // pad with zero
-      }
-    }
-    // chunk now has up to 24 bits of actual data, left-aligned
-    // We emit 4 Base64 chars, but some might become '=' padding
-    // Based on how many raw bytes we actually had.
-    for (int k = 0; k < 4; ++k) {
-      // For each 6-bit group: (from left to right in chunk)
-      int shift = 18 - (k * BITS_PER_CHAR);
-      uint32_t index = (chunk >> shift) & 0x3F;
-      // For 3 raw bytes, k goes 0..3 => all real
-      // For 2 raw bytes, k goes 0..2 => 3rd is '='
-      // For 1 raw byte, k goes 0..1 => 2nd/3rd are '='
-      if (k <= bytes_in_chunk) {
-        out[out_len++] = kBase64EncTable[index];
-      } else {
-        out[out_len++] = '=';
-      }
-    }
+  int64_t len_groups = len / 3 * 3;
+  Base64EncodeGroups(data, len_groups, out);
+  out_len = len_groups / 3 * 4;
+  if (len_groups < len) {
+    Base64EncodeTail(data + len_groups, len - len_groups, out + out_len);
+    out_len += 4;
   }
   out[out_len] = '\0';
   return ret;
@@ -334,7 +772,10 @@ Str Base64Decode(const uint8_t *data, int64_t len) {
   Str ret(::mlc::core::StrPad::Allocator::NewWithPad<uint8_t>((len / 4) * 3 + 1, 0));
   uint8_t *out = reinterpret_cast<uint8_t *>(ret.get()->::MLCStr::data);
   int64_t &result_len = ret.get()->::MLCStr::length;
-  for (int64_t i = 0; i < len; i += 4) {
+  // Blocks with padding or invalid characters are left to the scalar loop, which handles or reports them
+  int64_t simd_len = Base64DecodeSIMD(data, len, out);
+  result_len = simd_len / 4 * 3;
+  for (int64_t i = simd_len; i < len; i += 4) {
     // Each block of 4 chars -> up to 3 bytes
     uint32_t accum = 0;
     int valid_chars = 0;
@@ -398,32 +839,76 @@ template <typename T> MLC_INLINE T *WithOffset(Object *obj, MLCTypeField *field)
     if ((lhs != nullptr || rhs != nullptr) && (lhs == nullptr || rhs == nullptr || !EQ(*lhs, *rhs))) {                 \
       AnyView LHS = lhs ? AnyView(*lhs) : AnyView(nullptr);                                                            \
       AnyView RHS = rhs ? AnyView(*rhs) : AnyView(nullptr);                                                            \
-      MLC_CORE_EQ_S_ERR(LHS, RHS, path->WithField(field->name));                                                       \
+      MLC_CORE_EQ_S_ERR(LHS, RHS, TaskPath(*tasks, task_index)->WithField(field->name));                               \
     }                                                                                                                  \
   }
 #define MLC_CORE_EQ_S_POD(Type, EQ)                                                                                    \
   MLC_INLINE void operator()(MLCTypeField *field, StructureFieldKind, Type *lhs) {                                     \
     const Type *rhs = WithOffset<Type>(obj_rhs, field);                                                                \
     if (!EQ(*lhs, *rhs)) {                                                                                             \
-      MLC_CORE_EQ_S_ERR(AnyView(*lhs), AnyView(*rhs), path->WithField(field->name));                                   \
+      MLC_CORE_EQ_S_ERR(AnyView(*lhs), AnyView(*rhs), TaskPath(*tasks, task_index)->WithField(field->name));           \
     }                                                                                                                  \
   }
 
-inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
-  using CharArray = const char *;
-  using VoidPtr = ::mlc::base::VoidPtr;
-  using mlc::base::DataTypeEqual;
-  using mlc::base::DeviceEqual;
+/*!
+ * \brief Working state of `StructuralEqualImpl`, which batched callers keep per thread so that its capacity is
+ * reused across comparisons.
+ */
+struct StructuralEqualScratch {
+  // One step of the `ObjectPath` to a task, which is materialized only when an error is reported
+  struct PathStep {
+    int64_t parent; // index of the parent task, which stays on the stack until this task is popped
+    int32_t kind;   // same as `ObjectPathObj::kind`
+    AnyView key;
+  };
   struct Task {
     Object *lhs;
     Object *rhs;
     MLCTypeInfo *type_info;
     bool visited;
     bool bind_free_vars; // `map_free_vars` in TVM
-    ObjectPath path;
+    PathStep step;
     std::unique_ptr<std::ostringstream> err;
   };
+  void Clear() {
+    this->tasks.clear();
+    this->eq_lhs_to_rhs.clear();
+    this->eq_rhs_to_lhs.clear();
+  }
+  std::vector<Task> tasks;
+  std::unordered_map<Object *, Object *> eq_lhs_to_rhs;
+  std::unordered_map<Object *, Object *> eq_rhs_to_lhs;
+};
+
+inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars,
+                                StructuralEqualScratch *scratch = nullptr, bool same_free_vars_equal = false) {
+  using CharArray = const char *;
+  using VoidPtr = ::mlc::base::VoidPtr;
+  using mlc::base::DataTypeEqual;
+  using mlc::base::DeviceEqual;
+  using PathStep = StructuralEqualScratch::PathStep;
+  using Task = StructuralEqualScratch::Task;
   struct Visitor {
+    static ObjectPath MaterializePath(const std::vector<Task> &tasks, PathStep step) {
+      std::vector<PathStep> steps;
+      for (; step.kind != -1; step = tasks[step.parent].step) {
+        steps.push_back(step);
+      }
+      ObjectPath path = ObjectPath::Root();
+      for (auto it = steps.rbegin(); it != steps.rend(); ++it) {
+        if (it->kind == 0) {
+          path = path->WithField(it->key.operator const char *());
+        } else if (it->kind == 1) {
+          path = path->WithListIndex(it->key.operator int64_t());
+        } else {
+          path = path->WithDictKey(it->key);
+        }
+      }
+      return path;
+    }
+    static ObjectPath TaskPath(const std::vector<Task> &tasks, int64_t task_index) {
+      return MaterializePath(tasks, tasks[task_index].step);
+    }
     static bool CharArrayEqual(CharArray lhs, CharArray rhs) { return std::strcmp(lhs, rhs) == 0; }
     static bool FloatEqual(float lhs, float rhs) { return std::abs(lhs - rhs) < 1e-6; }
     static bool DoubleEqual(double lhs, double rhs) { return std::abs(lhs - rhs) < 1e-8; }
@@ -447,7 +932,7 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
     MLC_INLINE void operator()(MLCTypeField *field, StructureFieldKind field_kind, const Any *lhs) {
       const Any *rhs = WithOffset<Any>(obj_rhs, field);
       bool bind_free_vars = this->obj_bind_free_vars || field_kind == StructureFieldKind::kBind;
-      EnqueueAny(tasks, bind_free_vars, lhs, rhs, path->WithField(field->name));
+      EnqueueAny(tasks, bind_free_vars, lhs, rhs, PathStep{task_index, 0, AnyView(field->name)});
     }
     MLC_INLINE void operator()(MLCTypeField *field, StructureFieldKind field_kind, ObjectRef *_lhs) {
       HandleObject(field, field_kind, _lhs->get(), WithOffset<ObjectRef>(obj_rhs, field)->get());
@@ -458,105 +943,127 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
     inline void HandleObject(MLCTypeField *field, StructureFieldKind field_kind, Object *lhs, Object *rhs) {
       if (lhs || rhs) {
         bool bind_free_vars = this->obj_bind_free_vars || field_kind == StructureFieldKind::kBind;
-        EnqueueTask(tasks, bind_free_vars, lhs, rhs, path->WithField(field->name));
+        EnqueueTask(tasks, bind_free_vars, lhs, rhs, PathStep{task_index, 0, AnyView(field->name)});
       }
     }
-    static void CheckShapeEqual(const int64_t *lhs, const int64_t *rhs, int32_t ndim, const ObjectPath &path) {
+    static void CheckShapeEqual(const int64_t *lhs, const int64_t *rhs, int32_t ndim, const std::vector<Task> &tasks,
+                                PathStep step) {
       for (int32_t i = 0; i < ndim; ++i) {
         if (lhs[i] != rhs[i]) {
           UList lhs_list{lhs, lhs + ndim};
           UList rhs_list{rhs, rhs + ndim};
-          MLC_CORE_EQ_S_ERR(lhs_list, rhs_list, path->WithField("shape"));
+          MLC_CORE_EQ_S_ERR(lhs_list, rhs_list, MaterializePath(tasks, step)->WithField("shape"));
         }
       }
     }
-    static void CheckStridesEqual(const int64_t *lhs, const int64_t *rhs, int32_t ndim, const ObjectPath &path) {
+    static void CheckStridesEqual(const int64_t *lhs, const int64_t *rhs, int32_t ndim, const std::vector<Task> &tasks,
+                                  PathStep step) {
       if ((lhs == nullptr) != (rhs == nullptr)) {
         Any lhs_list = lhs ? Any(UList(lhs, lhs + ndim)) : Any();
         Any rhs_list = rhs ? Any(UList(rhs, rhs + ndim)) : Any();
-        MLC_CORE_EQ_S_ERR(lhs_list, rhs_list, path->WithField("strides"));
+        MLC_CORE_EQ_S_ERR(lhs_list, rhs_list, MaterializePath(tasks, step)->WithField("strides"));
       }
       for (int32_t i = 0; i < ndim; ++i) {
         if (lhs[i] != rhs[i]) {
           UList lhs_list{lhs, lhs + ndim};
           UList rhs_list{rhs, rhs + ndim};
-          MLC_CORE_EQ_S_ERR(lhs_list, rhs_list, path->WithField("strides"));
+          MLC_CORE_EQ_S_ERR(lhs_list, rhs_list, MaterializePath(tasks, step)->WithField("strides"));
         }
       }
     }
     static void EnqueueAny(std::vector<Task> *tasks, bool bind_free_vars, const Any *lhs, const Any *rhs,
-                           ObjectPath new_path) {
+                           PathStep step) {
+      auto path = [tasks, &step]() { return MaterializePath(*tasks, step); };
       int32_t type_index = lhs->GetTypeIndex();
+      if (type_index == kMLCSmallStr || rhs->GetTypeIndex() == kMLCSmallStr) {
+        // Small strings compare by content against both small and heap-allocated strings
+        const char *lhs_data = nullptr, *rhs_data = nullptr;
+        int64_t lhs_len = 0, rhs_len = 0;
+        if (::mlc::base::AnyStrView(*lhs, &lhs_data, &lhs_len) && ::mlc::base::AnyStrView(*rhs, &rhs_data, &rhs_len)) {
+          std::string_view lhs_str(lhs_data, lhs_len), rhs_str(rhs_data, rhs_len);
+          if (lhs_str != rhs_str) {
+            MLC_CORE_EQ_S_ERR(lhs_str, rhs_str, path());
+          }
+          return;
+        }
+      }
       if (type_index != rhs->GetTypeIndex()) {
-        MLC_CORE_EQ_S_ERR(lhs->GetTypeKey(), rhs->GetTypeKey(), new_path);
+        MLC_CORE_EQ_S_ERR(lhs->GetTypeKey(), rhs->GetTypeKey(), path());
       }
       if (type_index == kMLCNone) {
         return;
       }
-      MLC_CORE_EQ_S_ANY(type_index == kMLCBool, bool, std::equal_to<bool>(), lhs, rhs, new_path);
-      MLC_CORE_EQ_S_ANY(type_index == kMLCInt, int64_t, std::equal_to<int64_t>(), lhs, rhs, new_path);
-      MLC_CORE_EQ_S_ANY(type_index == kMLCFloat, double, DoubleEqual, lhs, rhs, new_path);
-      MLC_CORE_EQ_S_ANY(type_index == kMLCPtr, VoidPtr, std::equal_to<const void *>(), lhs, rhs, new_path);
-      MLC_CORE_EQ_S_ANY(type_index == kMLCDataType, DLDataType, DataTypeEqual, lhs, rhs, new_path);
-      MLC_CORE_EQ_S_ANY(type_index == kMLCDevice, DLDevice, DeviceEqual, lhs, rhs, new_path);
-      MLC_CORE_EQ_S_ANY(type_index == kMLCRawStr, CharArray, CharArrayEqual, lhs, rhs, new_path);
+      MLC_CORE_EQ_S_ANY(type_index == kMLCBool, bool, std::equal_to<bool>(), lhs, rhs, path());
+      MLC_CORE_EQ_S_ANY(type_index == kMLCInt, int64_t, std::equal_to<int64_t>(), lhs, rhs, path());
+      MLC_CORE_EQ_S_ANY(type_index == kMLCFloat, double, DoubleEqual, lhs, rhs, path());
+      MLC_CORE_EQ_S_ANY(type_index == kMLCPtr, VoidPtr, std::equal_to<const void *>(), lhs, rhs, path());
+      MLC_CORE_EQ_S_ANY(type_index == kMLCDataType, DLDataType, DataTypeEqual, lhs, rhs, path());
+      MLC_CORE_EQ_S_ANY(type_index == kMLCDevice, DLDevice, DeviceEqual, lhs, rhs, path());
+      MLC_CORE_EQ_S_ANY(type_index == kMLCRawStr, CharArray, CharArrayEqual, lhs, rhs, path());
       if (type_index < kMLCStaticObjectBegin) {
         MLC_THROW(InternalError) << "Unknown type key: " << lhs->GetTypeKey();
       }
-      EnqueueTask(tasks, bind_free_vars, lhs->operator Object *(), rhs->operator Object *(), new_path);
+      EnqueueTask(tasks, bind_free_vars, lhs->operator Object *(), rhs->operator Object *(), step);
     }
     static void EnqueueTask(std::vector<Task> *tasks, bool bind_free_vars, Object *lhs, Object *rhs,
-                            ObjectPath new_path) {
+                            PathStep step) {
+      auto path = [tasks, &step]() { return MaterializePath(*tasks, step); };
       int32_t lhs_type_index = lhs ? lhs->GetTypeIndex() : kMLCNone;
       int32_t rhs_type_index = rhs ? rhs->GetTypeIndex() : kMLCNone;
       if (lhs_type_index != rhs_type_index) {
-        MLC_CORE_EQ_S_ERR(Lib::GetTypeKey(lhs_type_index), Lib::GetTypeKey(rhs_type_index), new_path);
+        MLC_CORE_EQ_S_ERR(Lib::GetTypeKey(lhs_type_index), Lib::GetTypeKey(rhs_type_index), path());
       } else if (lhs_type_index == kMLCStr) {
         Str lhs_str(reinterpret_cast<StrObj *>(lhs));
         Str rhs_str(reinterpret_cast<StrObj *>(rhs));
         if (lhs_str != rhs_str) {
-          MLC_CORE_EQ_S_ERR(lhs_str, rhs_str, new_path);
+          MLC_CORE_EQ_S_ERR(lhs_str, rhs_str, path());
         }
       } else if (lhs_type_index == kMLCTensor) {
         DLTensor *lhs_tensor = &lhs->Cast<TensorObj>()->tensor;
         DLTensor *rhs_tensor = &rhs->Cast<TensorObj>()->tensor;
         int32_t ndim = lhs_tensor->ndim;
         if (ndim != rhs_tensor->ndim) {
-          MLC_CORE_EQ_S_ERR(lhs_tensor->ndim, rhs_tensor->ndim, new_path->WithField("ndim"));
+          MLC_CORE_EQ_S_ERR(lhs_tensor->ndim, rhs_tensor->ndim, path()->WithField("ndim"));
         }
         if (lhs_tensor->byte_offset != rhs_tensor->byte_offset) {
-          MLC_CORE_EQ_S_ERR(lhs_tensor->byte_offset, rhs_tensor->byte_offset, new_path->WithField("byte_offset"));
+          MLC_CORE_EQ_S_ERR(lhs_tensor->byte_offset, rhs_tensor->byte_offset, path()->WithField("byte_offset"));
         }
         if (!::mlc::base::DataTypeEqual(lhs_tensor->dtype, rhs_tensor->dtype)) {
-          MLC_CORE_EQ_S_ERR(AnyView(lhs_tensor->dtype), AnyView(rhs_tensor->dtype), new_path->WithField("dtype"));
+          MLC_CORE_EQ_S_ERR(AnyView(lhs_tensor->dtype), AnyView(rhs_tensor->dtype), path()->WithField("dtype"));
         }
         if (!::mlc::base::DeviceEqual(lhs_tensor->device, rhs_tensor->device)) {
-          MLC_CORE_EQ_S_ERR(AnyView(lhs_tensor->device), AnyView(rhs_tensor->device), new_path->WithField("device"));
+          MLC_CORE_EQ_S_ERR(AnyView(lhs_tensor->device), AnyView(rhs_tensor->device), path()->WithField("device"));
         }
-        CheckShapeEqual(lhs_tensor->shape, rhs_tensor->shape, ndim, new_path);
-        CheckStridesEqual(lhs_tensor->strides, rhs_tensor->strides, ndim, new_path);
+        CheckShapeEqual(lhs_tensor->shape, rhs_tensor->shape, ndim, *tasks, step);
+        CheckStridesEqual(lhs_tensor->strides, rhs_tensor->strides, ndim, *tasks, step);
       } else if (lhs_type_index == kMLCFunc || lhs_type_index == kMLCError) {
-        throw SEqualError("Cannot compare `mlc.Func` or `mlc.Error`", new_path);
+        throw SEqualError("Cannot compare `mlc.Func` or `mlc.Error`", path());
       } else if (lhs_type_index == kMLCOpaque) {
         std::ostringstream err;
         err << "Cannot compare `mlc.Opaque` of type: " << lhs->Cast<OpaqueObj>()->opaque_type_name;
-        throw SEqualError(err.str().c_str(), new_path);
+        throw SEqualError(err.str().c_str(), path());
       } else {
         bool visited = false;
         MLCTypeInfo *type_info = Lib::GetTypeInfo(lhs_type_index);
-        tasks->push_back(Task{lhs, rhs, type_info, visited, bind_free_vars, new_path, nullptr});
+        tasks->push_back(Task{lhs, rhs, type_info, visited, bind_free_vars, step, nullptr});
       }
     }
     Object *obj_rhs;
     std::vector<Task> *tasks;
     bool obj_bind_free_vars;
-    ObjectPath path;
+    int64_t task_index;
   };
-  std::vector<Task> tasks;
-  std::unordered_map<Object *, Object *> eq_lhs_to_rhs;
-  std::unordered_map<Object *, Object *> eq_rhs_to_lhs;
+  StructuralEqualScratch local_scratch;
+  if (scratch == nullptr) {
+    scratch = &local_scratch;
+  } else {
+    scratch->Clear();
+  }
+  std::vector<Task> &tasks = scratch->tasks;
+  std::unordered_map<Object *, Object *> &eq_lhs_to_rhs = scratch->eq_lhs_to_rhs;
+  std::unordered_map<Object *, Object *> &eq_rhs_to_lhs = scratch->eq_rhs_to_lhs;
 
-  auto check_bind = [&eq_lhs_to_rhs, &eq_rhs_to_lhs](Object *lhs, Object *rhs, const ObjectPath &path) -> bool {
+  auto check_bind = [&tasks, &eq_lhs_to_rhs, &eq_rhs_to_lhs](Object *lhs, Object *rhs, int64_t task_index) -> bool {
     // check binding consistency: lhs -> rhs, rhs -> lhs
     auto it_lhs_to_rhs = eq_lhs_to_rhs.find(lhs);
     auto it_rhs_to_lhs = eq_rhs_to_lhs.find(rhs);
@@ -567,32 +1074,34 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
       if (it_lhs_to_rhs->second == rhs && it_rhs_to_lhs->second == lhs) {
         return true;
       }
-      throw SEqualError("Inconsistent binding: LHS and RHS are both bound, but to different nodes", path);
+      throw SEqualError("Inconsistent binding: LHS and RHS are both bound, but to different nodes",
+                        Visitor::TaskPath(tasks, task_index));
     }
     // inconsistent binding
     if (exist_lhs_to_rhs) {
-      throw SEqualError("Inconsistent binding. LHS has been bound to a different node while RHS is not bound", path);
+      throw SEqualError("Inconsistent binding. LHS has been bound to a different node while RHS is not bound",
+                        Visitor::TaskPath(tasks, task_index));
     }
     if (exist_rhs_to_lhs) {
-      throw SEqualError("Inconsistent binding. RHS has been bound to a different node while LHS is not bound", path);
+      throw SEqualError("Inconsistent binding. RHS has been bound to a different node while LHS is not bound",
+                        Visitor::TaskPath(tasks, task_index));
     }
     return false;
   };
 
-  Visitor::EnqueueTask(&tasks, bind_free_vars, lhs, rhs, ObjectPath::Root());
+  Visitor::EnqueueTask(&tasks, bind_free_vars, lhs, rhs, PathStep{-1, -1, AnyView()});
   while (!tasks.empty()) {
     MLCTypeInfo *type_info;
-    ObjectPath path{::mlc::Null};
+    int64_t task_index = static_cast<int64_t>(tasks.size()) - 1;
     {
       Task &task = tasks.back();
       type_info = task.type_info;
-      path = task.path;
       lhs = task.lhs;
       rhs = task.rhs;
       bind_free_vars = task.bind_free_vars;
       if (task.err) {
-        throw SEqualError(task.err->str().c_str(), path);
-      } else if (check_bind(lhs, rhs, path)) {
+        throw SEqualError(task.err->str().c_str(), Visitor::TaskPath(tasks, task_index));
+      } else if (check_bind(lhs, rhs, task_index)) {
         tasks.pop_back();
         continue;
       } else if (task.visited) {
@@ -601,8 +1110,8 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
           // bind lhs <-> rhs
           eq_lhs_to_rhs[lhs] = rhs;
           eq_rhs_to_lhs[rhs] = lhs;
-        } else if (kind == StructureKind::kVar && !bind_free_vars) {
-          throw SEqualError("Unbound variable", path);
+        } else if (kind == StructureKind::kVar && !bind_free_vars && !(same_free_vars_equal && lhs == rhs)) {
+          throw SEqualError("Unbound variable", Visitor::TaskPath(tasks, task_index));
         }
         tasks.pop_back();
         continue;
@@ -610,14 +1119,14 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
       task.visited = true;
     }
     // `task.visited` was `False`
-    int64_t task_index = static_cast<int64_t>(tasks.size()) - 1;
     if (type_info->type_index == kMLCList) {
       UListObj *lhs_list = reinterpret_cast<UListObj *>(lhs);
       UListObj *rhs_list = reinterpret_cast<UListObj *>(rhs);
       int64_t lhs_size = lhs_list->size();
       int64_t rhs_size = rhs_list->size();
       for (int64_t i = (lhs_size < rhs_size ? lhs_size : rhs_size) - 1; i >= 0; --i) {
-        Visitor::EnqueueAny(&tasks, bind_free_vars, &lhs_list->at(i), &rhs_list->at(i), path->WithListIndex(i));
+        Visitor::EnqueueAny(&tasks, bind_free_vars, &lhs_list->at(i), &rhs_list->at(i),
+                            PathStep{task_index, 1, AnyView(i)});
       }
       if (lhs_size != rhs_size) {
         auto &err = tasks[task_index].err = std::make_unique<std::ostringstream>();
@@ -643,7 +1152,7 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
           not_found_lhs_keys.push_back(lhs_key);
           continue;
         }
-        Visitor::EnqueueAny(&tasks, bind_free_vars, &kv.second, &rhs_it->second, path->WithDictKey(lhs_key));
+        Visitor::EnqueueAny(&tasks, bind_free_vars, &kv.second, &rhs_it->second, PathStep{task_index, 2, lhs_key});
       }
       auto &err = tasks[task_index].err;
       if (!not_found_lhs_keys.empty()) {
@@ -657,7 +1166,7 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
         (*err) << "Dict size mismatch: " << lhs_dict->size() << " vs " << rhs_dict->size();
       }
     } else {
-      VisitStructure(lhs, type_info, Visitor{rhs, &tasks, bind_free_vars, path});
+      VisitStructure(lhs, type_info, Visitor{rhs, &tasks, bind_free_vars, task_index});
     }
   }
 }
@@ -669,20 +1178,19 @@ inline void StructuralEqualImpl(Object *lhs, Object *rhs, bool bind_free_vars) {
     if (const Type *v = _v->get()) {                                                                                   \
       EnqueuePOD(tasks, Hasher(*v));                                                                                   \
     } else {                                                                                                           \
-      EnqueuePOD(tasks, HashCache::kNoneCombined);                                                                     \
+      EnqueuePOD(tasks, HashNone());                                                                                   \
     }                                                                                                                  \
   }
 #define MLC_CORE_HASH_S_POD(Type, Hasher)                                                                              \
   MLC_INLINE void operator()(MLCTypeField *, StructureFieldKind, Type *v) { EnqueuePOD(tasks, Hasher(*v)); }
 #define MLC_CORE_HASH_S_ANY(Cond, Type, Hasher)                                                                        \
   if (Cond) {                                                                                                          \
-    EnqueuePOD(tasks, Hasher(v->operator Type()));                                                                     \
+    EnqueuePOD(tasks, Hasher(static_cast<Type>(*v)));                                                                  \
     return;                                                                                                            \
   }
 
 struct HashCache {
-  inline static const uint64_t MLC_SYMBOL_HIDE kNoneCombined =
-      ::mlc::base::HashCombine(Lib::GetTypeInfo(kMLCNone)->type_key_hash, 0);
+  inline static const uint64_t MLC_SYMBOL_HIDE kNone = Lib::GetTypeInfo(kMLCNone)->type_key_hash;
   inline static const uint64_t MLC_SYMBOL_HIDE kBool = Lib::GetTypeInfo(kMLCBool)->type_key_hash;
   inline static const uint64_t MLC_SYMBOL_HIDE kInt = Lib::GetTypeInfo(kMLCInt)->type_key_hash;
   inline static const uint64_t MLC_SYMBOL_HIDE kFloat = Lib::GetTypeInfo(kMLCFloat)->type_key_hash;
@@ -696,39 +1204,176 @@ struct HashCache {
   inline static const uint64_t MLC_SYMBOL_HIDE kUnbound = ::mlc::base::StrHash("$$Unbound$$");
 };
 
-template <typename T> MLC_INLINE uint64_t HashTyped(uint64_t type_hash, T value) {
+/*! \brief 64-bit structural hash, which combines values boost-style. */
+struct Hash64 {
+  using Value = uint64_t;
+  MLC_INLINE static Value Seed(uint64_t seed) { return seed; }
+  MLC_INLINE static Value Combine(Value seed, uint64_t value) { return ::mlc::base::HashCombine(seed, value); }
+  MLC_INLINE static Value CombineValue(Value seed, Value value) { return ::mlc::base::HashCombine(seed, value); }
+  MLC_INLINE static Value TypedStr(uint64_t type_hash, const char *data, int64_t length) {
+    return ::mlc::base::HashCombine(type_hash, ::mlc::base::StrHash(data, length));
+  }
+  MLC_INLINE static Value TypedStr(uint64_t type_hash, const MLCStr *str) {
+    return ::mlc::base::HashCombine(type_hash, ::mlc::base::StrHash(str));
+  }
+};
+
+/*!
+ * \brief 128-bit structural hash for callers that trust hash equality, e.g. keys of large caches. Each value
+ * is folded into two lanes with different seeds and rotations, each well mixed by the MurmurHash3 finalizer.
+ */
+struct Hash128 {
+  struct Value {
+    uint64_t lo;
+    uint64_t hi;
+    MLC_INLINE bool operator<(const Value &other) const { return lo != other.lo ? lo < other.lo : hi < other.hi; }
+    MLC_INLINE bool operator==(const Value &other) const { return lo == other.lo && hi == other.hi; }
+  };
+  MLC_INLINE static uint64_t Mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+  }
+  MLC_INLINE static Value Seed(uint64_t seed) {
+    return Value{Mix(seed ^ 0x9e3779b97f4a7c15ULL), Mix(seed ^ 0xd6e8feb86659fd93ULL)};
+  }
+  MLC_INLINE static Value Combine(Value seed, uint64_t value) {
+    uint64_t lo = Mix(seed.lo ^ value);
+    uint64_t hi = Mix(seed.hi ^ ((value << 32) | (value >> 32))) + lo;
+    return Value{lo, hi};
+  }
+  MLC_INLINE static Value CombineValue(Value seed, Value value) { return Combine(Combine(seed, value.lo), value.hi); }
+  inline static Value TypedStr(uint64_t type_hash, const char *data, int64_t length) {
+    Value result = Seed(type_hash);
+    int64_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+      uint64_t word;
+      std::memcpy(&word, data + i, 8);
+      result = Combine(result, word);
+    }
+    if (i < length) {
+      uint64_t word = 0;
+      std::memcpy(&word, data + i, static_cast<size_t>(length - i));
+      result = Combine(result, word);
+    }
+    return Combine(result, static_cast<uint64_t>(length));
+  }
+  MLC_INLINE static Value TypedStr(uint64_t type_hash, const MLCStr *str) {
+    return TypedStr(type_hash, str->data, str->length);
+  }
+};
+
+template <typename Hasher, typename T> MLC_INLINE typename Hasher::Value HashTyped(uint64_t type_hash, T value) {
   union {
     T src;
     uint64_t tgt;
   } u;
   u.tgt = 0;
   u.src = value;
-  return ::mlc::base::HashCombine(type_hash, u.tgt);
+  return Hasher::Combine(Hasher::Seed(type_hash), u.tgt);
 }
 
-inline uint64_t StructuralHashImpl(Object *obj) {
-  using CharArray = const char *;
-  using VoidPtr = ::mlc::base::VoidPtr;
-  using mlc::base::HashCombine;
-  struct Task {
-    Object *obj;
-    MLCTypeInfo *type_info;
-    bool visited;
-    bool bind_free_vars;
-    uint64_t hash_value;
-    size_t index_in_result_hashes{0xffffffffffffffff};
+/*!
+ * \brief Structural hashes of closed subtrees, kept across calls to `StructuralHashImpl`. A subtree is closed
+ * if it contains no variables, lists or dicts, and all its sub-structure fields are frozen, so its hash
+ * cannot change as long as the memo keeps it alive.
+ */
+template <typename Hasher> struct StructuralHashMemo {
+  using Value = typename Hasher::Value;
+  struct Entry {
+    ObjectRef obj;
+    Value hash;
   };
-  struct Visitor {
-    static uint64_t HashBool(bool a) { return HashTyped<int64_t>(HashCache::kBool, static_cast<int64_t>(a)); }
-    static uint64_t HashInteger(int64_t a) { return HashTyped<int64_t>(HashCache::kInt, a); }
-    static uint64_t HashPtr(VoidPtr a) { return HashTyped<VoidPtr>(HashCache::kPtr, a); }
-    static uint64_t HashDevice(DLDevice a) { return HashTyped<DLDevice>(HashCache::kDevice, a); }
-    static uint64_t HashDataType(DLDataType a) { return HashTyped<DLDataType>(HashCache::kDType, a); }
-    // clang-format off
-    static uint64_t HashFloat(float a) { return HashTyped<float>(HashCache::kFloat, std::isnan(a) ? std::numeric_limits<float>::quiet_NaN() : a); }
-    static uint64_t HashDouble(double a) { return HashTyped<double>(HashCache::kFloat, std::isnan(a) ? std::numeric_limits<double>::quiet_NaN() : a); }
-    static uint64_t HashCharArray(CharArray a) { return HashTyped<uint64_t>(HashCache::kRawStr, ::mlc::base::StrHash(a)); }
-    // clang-format on
+
+  const Entry *Find(Object *obj) const {
+    auto it = this->entries.find(obj);
+    return it == this->entries.end() ? nullptr : &it->second;
+  }
+
+  void Insert(Object *obj, Value hash) {
+    if (this->entries.emplace(obj, Entry{ObjectRef(obj), hash}).second && this->journal != nullptr) {
+      this->journal->push_back(obj);
+    }
+  }
+
+  void Erase(Object *obj) { this->entries.erase(obj); }
+
+  bool IsClosedType(MLCTypeInfo *type_info) {
+    int32_t type_index = type_info->type_index;
+    if (static_cast<size_t>(type_index) >= this->closed_types.size()) {
+      this->closed_types.resize(type_index + 1, -1);
+    }
+    int8_t &closed = this->closed_types[type_index];
+    if (closed == -1) {
+      closed = type_index != kMLCList && type_index != kMLCDict &&
+               type_info->structure_kind == static_cast<int32_t>(StructureKind::kNoBind);
+      if (const MLCVisitOp *op = type_info->structure_plan) {
+        for (; closed && op->kind != kMLCVisitEnd; ++op) {
+          closed = this->assume_immutable || op->field->frozen;
+        }
+      }
+    }
+    return closed;
+  }
+
+  std::unordered_map<Object *, Entry> entries;
+  std::vector<int8_t> closed_types;
+  // Trusts mutable fields too, for owners that never mutate what they cache
+  bool assume_immutable = false;
+  // Records the objects inserted, for owners that only keep some of them
+  std::vector<Object *> *journal = nullptr;
+  // Taken around each call through a handle, which may be shared across threads
+  std::mutex mutex;
+};
+
+/*!
+ * \brief Working state of `StructuralHashImpl`, which batched callers keep per thread so that its capacity is
+ * reused across roots.
+ */
+template <typename Hasher> struct StructuralHashScratch {
+  using Value = typename Hasher::Value;
+  struct Task {
+    Object *obj;
+    MLCTypeInfo *type_info;
+    bool visited;
+    bool bind_free_vars;
+    Value hash_value;
+    size_t index_in_result_hashes{0xffffffffffffffff};
+  };
+  void Clear() {
+    this->tasks.clear();
+    this->result_hashes.clear();
+    this->result_closed.clear();
+    this->obj2hash.clear();
+  }
+  std::vector<Task> tasks;
+  std::vector<Value> result_hashes;
+  std::vector<bool> result_closed; // Only tracked with a memo
+  std::unordered_map<Object *, Value> obj2hash;
+};
+
+template <typename Hasher>
+inline typename Hasher::Value StructuralHashImpl(Object *obj, StructuralHashMemo<Hasher> *memo = nullptr,
+                                                 StructuralHashScratch<Hasher> *scratch = nullptr) {
+  using CharArray = const char *;
+  using VoidPtr = ::mlc::base::VoidPtr;
+  using Value = typename Hasher::Value;
+  using Task = typename StructuralHashScratch<Hasher>::Task;
+  struct Visitor {
+    static Value HashNone() { return HashTyped<Hasher, int64_t>(HashCache::kNone, 0); }
+    static Value HashBool(bool a) { return HashTyped<Hasher, int64_t>(HashCache::kBool, static_cast<int64_t>(a)); }
+    static Value HashInteger(int64_t a) { return HashTyped<Hasher, int64_t>(HashCache::kInt, a); }
+    static Value HashPtr(VoidPtr a) { return HashTyped<Hasher, VoidPtr>(HashCache::kPtr, a); }
+    static Value HashDevice(DLDevice a) { return HashTyped<Hasher, DLDevice>(HashCache::kDevice, a); }
+    static Value HashDataType(DLDataType a) { return HashTyped<Hasher, DLDataType>(HashCache::kDType, a); }
+    // clang-format off
+    static Value HashFloat(float a) { return HashTyped<Hasher, float>(HashCache::kFloat, std::isnan(a) ? std::numeric_limits<float>::quiet_NaN() : a); }
+    static Value HashDouble(double a) { return HashTyped<Hasher, double>(HashCache::kFloat, std::isnan(a) ? std::numeric_limits<double>::quiet_NaN() : a); }
+    static Value HashCharArray(CharArray a) { return Hasher::TypedStr(HashCache::kRawStr, a, static_cast<int64_t>(std::strlen(a))); }
+    // clang-format on
     MLC_CORE_HASH_S_OPT(bool, HashBool);
     MLC_CORE_HASH_S_OPT(int64_t, HashInteger);
     MLC_CORE_HASH_S_OPT(double, HashDouble);
@@ -760,7 +1405,7 @@ inline uint64_t StructuralHashImpl(Object *obj) {
       bool bind_free_vars = this->obj_bind_free_vars || field_kind == StructureFieldKind::kBind;
       EnqueueTask(tasks, bind_free_vars, v);
     }
-    static void EnqueuePOD(std::vector<Task> *tasks, uint64_t hash_value) {
+    static void EnqueuePOD(std::vector<Task> *tasks, Value hash_value) {
       tasks->emplace_back(Task{nullptr, nullptr, false, false, hash_value});
     }
     static void EnqueueAny(std::vector<Task> *tasks, bool bind_free_vars, const Any *v) {
@@ -772,32 +1417,34 @@ inline uint64_t StructuralHashImpl(Object *obj) {
       MLC_CORE_HASH_S_ANY(type_index == kMLCDataType, DLDataType, HashDataType);
       MLC_CORE_HASH_S_ANY(type_index == kMLCDevice, DLDevice, HashDevice);
       MLC_CORE_HASH_S_ANY(type_index == kMLCRawStr, CharArray, HashCharArray);
-      EnqueueTask(tasks, bind_free_vars, v->operator Object *());
+      if (type_index == kMLCSmallStr) {
+        // Hashed identically to a heap-allocated `Str` of the same content
+        EnqueuePOD(tasks, Hasher::TypedStr(HashCache::kStrObj, v->v.v_bytes, v->small_len));
+        return;
+      }
+      EnqueueTask(tasks, bind_free_vars, static_cast<Object *>(*v));
     }
     static void EnqueueTask(std::vector<Task> *tasks, bool bind_free_vars, Object *obj) {
       int32_t type_index = obj ? obj->GetTypeIndex() : kMLCNone;
       if (type_index == kMLCNone) {
-        EnqueuePOD(tasks, HashCache::kNoneCombined);
+        EnqueuePOD(tasks, HashNone());
       } else if (type_index == kMLCStr) {
-        const MLCStr *str = reinterpret_cast<const MLCStr *>(obj);
-        uint64_t hash_value = ::mlc::base::StrHash(str->data, str->length);
-        hash_value = HashTyped(HashCache::kStrObj, hash_value);
-        EnqueuePOD(tasks, hash_value);
+        EnqueuePOD(tasks, Hasher::TypedStr(HashCache::kStrObj, reinterpret_cast<const MLCStr *>(obj)));
       } else if (type_index == kMLCTensor) {
         const DLTensor *tensor = &reinterpret_cast<const MLCTensor *>(obj)->tensor;
-        uint64_t hash_value = HashInteger(tensor->ndim);
-        hash_value = HashCombine(hash_value, HashInteger(tensor->byte_offset));
-        hash_value = HashCombine(hash_value, HashDataType(tensor->dtype));
-        hash_value = HashCombine(hash_value, HashDevice(tensor->device));
+        Value hash_value = HashInteger(tensor->ndim);
+        hash_value = Hasher::CombineValue(hash_value, HashInteger(tensor->byte_offset));
+        hash_value = Hasher::CombineValue(hash_value, HashDataType(tensor->dtype));
+        hash_value = Hasher::CombineValue(hash_value, HashDevice(tensor->device));
         for (int32_t i = 0; i < tensor->ndim; ++i) {
-          hash_value = HashCombine(hash_value, HashInteger(tensor->shape[i]));
+          hash_value = Hasher::CombineValue(hash_value, HashInteger(tensor->shape[i]));
         }
         if (tensor->strides) {
           for (int32_t i = 0; i < tensor->ndim; ++i) {
-            hash_value = HashCombine(hash_value, HashInteger(tensor->strides[i]));
+            hash_value = Hasher::CombineValue(hash_value, HashInteger(tensor->strides[i]));
           }
         }
-        hash_value = HashTyped(HashCache::kTensorObj, hash_value);
+        hash_value = Hasher::CombineValue(Hasher::Seed(HashCache::kTensorObj), hash_value);
         EnqueuePOD(tasks, hash_value);
       } else if (type_index == kMLCFunc || type_index == kMLCError) {
         throw SEqualError("Cannot compare `mlc.Func` or `mlc.Error`", ObjectPath::Root());
@@ -807,23 +1454,32 @@ inline uint64_t StructuralHashImpl(Object *obj) {
         throw SEqualError(err.str().c_str(), ObjectPath::Root());
       } else {
         MLCTypeInfo *type_info = Lib::GetTypeInfo(type_index);
-        tasks->emplace_back(Task{obj, type_info, false, bind_free_vars, type_info->type_key_hash});
+        tasks->emplace_back(Task{obj, type_info, false, bind_free_vars, Hasher::Seed(type_info->type_key_hash)});
       }
     }
 
     std::vector<Task> *tasks;
     bool obj_bind_free_vars;
   };
-  std::vector<Task> tasks;
-  std::vector<uint64_t> result_hashes;
-  std::unordered_map<Object *, uint64_t> obj2hash;
+  StructuralHashScratch<Hasher> local_scratch;
+  if (scratch == nullptr) {
+    scratch = &local_scratch;
+  } else {
+    scratch->Clear();
+  }
+  std::vector<Task> &tasks = scratch->tasks;
+  std::vector<Value> &result_hashes = scratch->result_hashes;
+  std::vector<bool> &result_closed = scratch->result_closed; // Only tracked with `memo`
+  std::unordered_map<Object *, Value> &obj2hash = scratch->obj2hash;
   int64_t num_bound_nodes = 0;
   int64_t num_unbound_vars = 0;
+  Object *root = obj;
+  bool memo_hit = false;
   Visitor::EnqueueTask(&tasks, false, obj);
   while (!tasks.empty()) {
     MLCTypeInfo *type_info;
     bool bind_free_vars;
-    uint64_t hash_value;
+    Value hash_value;
     {
       Task &task = tasks.back();
       hash_value = task.hash_value;
@@ -837,15 +1493,26 @@ inline uint64_t StructuralHashImpl(Object *obj) {
               << result_hashes.size() << " vs " << task.index_in_result_hashes << ")";
         }
         for (; result_hashes.size() > task.index_in_result_hashes; result_hashes.pop_back()) {
-          hash_value = HashCombine(hash_value, result_hashes.back());
+          hash_value = Hasher::CombineValue(hash_value, result_hashes.back());
+        }
+        bool closed = false;
+        if (memo != nullptr) {
+          closed = memo->IsClosedType(type_info);
+          for (; result_closed.size() > task.index_in_result_hashes; result_closed.pop_back()) {
+            closed = closed && result_closed.back();
+          }
+          if (closed) {
+            memo->Insert(obj, hash_value);
+          }
+          result_closed.push_back(closed);
         }
         StructureKind kind = static_cast<StructureKind>(type_info->structure_kind);
         if (kind == StructureKind::kBind || (kind == StructureKind::kVar && bind_free_vars)) {
-          hash_value = HashCombine(hash_value, HashCache::kBound);
-          hash_value = HashCombine(hash_value, num_bound_nodes++);
+          hash_value = Hasher::Combine(hash_value, HashCache::kBound);
+          hash_value = Hasher::Combine(hash_value, static_cast<uint64_t>(num_bound_nodes++));
         } else if (kind == StructureKind::kVar && !bind_free_vars) {
-          hash_value = HashCombine(hash_value, HashCache::kUnbound);
-          hash_value = HashCombine(hash_value, num_unbound_vars++);
+          hash_value = Hasher::Combine(hash_value, HashCache::kUnbound);
+          hash_value = Hasher::Combine(hash_value, static_cast<uint64_t>(num_unbound_vars++));
         }
         obj2hash[obj] = hash_value;
         result_hashes.push_back(hash_value);
@@ -853,10 +1520,23 @@ inline uint64_t StructuralHashImpl(Object *obj) {
         continue;
       } else if (auto it = obj2hash.find(obj); it != obj2hash.end()) {
         result_hashes.push_back(it->second);
+        if (memo != nullptr) {
+          result_closed.push_back(memo->Find(obj) != nullptr);
+        }
         tasks.pop_back();
         continue;
       } else if (obj == nullptr) {
         result_hashes.push_back(hash_value);
+        if (memo != nullptr) {
+          result_closed.push_back(true);
+        }
+        tasks.pop_back();
+        continue;
+      } else if (const auto *entry = memo ? memo->Find(obj) : nullptr) {
+        obj2hash[obj] = entry->hash;
+        result_hashes.push_back(entry->hash);
+        result_closed.push_back(true);
+        memo_hit = true;
         tasks.pop_back();
         continue;
       }
@@ -866,23 +1546,23 @@ inline uint64_t StructuralHashImpl(Object *obj) {
     // `task.visited` was `False`
     if (type_info->type_index == kMLCList) {
       UListObj *list = reinterpret_cast<UListObj *>(obj);
-      hash_value = HashCombine(hash_value, list->size());
+      hash_value = Hasher::Combine(hash_value, static_cast<uint64_t>(list->size()));
       for (int64_t i = list->size() - 1; i >= 0; --i) {
         Visitor::EnqueueAny(&tasks, bind_free_vars, &list->at(i));
       }
     } else if (type_info->type_index == kMLCDict) {
       UDictObj *dict = reinterpret_cast<UDictObj *>(obj);
-      hash_value = HashCombine(hash_value, dict->size());
+      hash_value = Hasher::Combine(hash_value, static_cast<uint64_t>(dict->size()));
       struct KVPair {
-        uint64_t hash;
+        Value hash;
         AnyView key;
         AnyView value;
       };
       std::vector<KVPair> kv_pairs;
       for (auto &[k, v] : *dict) {
-        uint64_t hash = 0;
+        Value hash{};
         if (k.type_index == kMLCNone) {
-          hash = HashCache::kNoneCombined;
+          hash = Visitor::HashNone();
         } else if (k.type_index == kMLCBool) {
           hash = Visitor::HashInteger(k.v.v_bool);
         } else if (k.type_index == kMLCInt) {
@@ -896,13 +1576,17 @@ inline uint64_t StructuralHashImpl(Object *obj) {
         } else if (k.type_index == kMLCDevice) {
           hash = Visitor::HashDevice(k.v.v_device);
         } else if (k.type_index == kMLCStr) {
-          const StrObj *str = k;
-          hash = ::mlc::base::StrHash(str->data(), str->length());
-          hash = HashTyped(HashCache::kStrObj, hash);
+          hash = Hasher::TypedStr(HashCache::kStrObj, reinterpret_cast<const MLCStr *>(k.v.v_obj));
+        } else if (k.type_index == kMLCSmallStr) {
+          hash = Hasher::TypedStr(HashCache::kStrObj, k.v.v_bytes, k.small_len);
         } else if (k.type_index >= kMLCStaticObjectBegin) {
           obj = k;
           if (auto it = obj2hash.find(obj); it != obj2hash.end()) {
             hash = it->second;
+          } else if (memo_hit) {
+            // The key may lie inside a memoized subtree whose nodes were not visited, so start over without
+            // the memo to produce the same hash as an unmemoized traversal
+            return StructuralHashImpl<Hasher>(root, nullptr);
           } else {
             continue; // Skip unbound nodes
           }
@@ -922,6 +1606,7 @@ inline uint64_t StructuralHashImpl(Object *obj) {
           Visitor::EnqueueAny(&tasks, bind_free_vars, &k);
           Visitor::EnqueueAny(&tasks, bind_free_vars, &v);
         }
+        i = j;
       }
     } else {
       VisitStructure(obj, type_info, Visitor{&tasks, bind_free_vars});
@@ -942,8 +1627,271 @@ inline uint64_t StructuralHashImpl(Object *obj) {
 #undef MLC_CORE_HASH_S_POD
 #undef MLC_CORE_HASH_S_ANY
 
+/****************** Remap ******************/
+
+/*!
+ * \brief Returns `object` with each child object replaced by what `orig2new` maps it to, which must hold every
+ * child. Lists, dicts and objects are rebuilt, the latter through their `__init__`, only if a child is replaced.
+ * Strings and objects without fields, such as functions, errors, tensors and opaque objects, are not supported.
+ * On return, `fields` holds the replaced children.
+ */
+inline Any RemapChildren(Object *object, MLCTypeInfo *type_info,
+                         const std::unordered_map<const Object *, Any> &orig2new, std::vector<AnyView> *fields) {
+  struct Remapper {
+    MLC_INLINE void operator()(MLCTypeField *, const Any *any) { HandleAny(any); }
+    MLC_INLINE void operator()(MLCTypeField *, ObjectRef *ref) { HandleObject(ref->get()); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<ObjectRef> *opt) { HandleObject(opt->get()); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<bool> *opt) { fields->push_back(AnyView(*opt)); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<int64_t> *opt) { fields->push_back(AnyView(*opt)); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<double> *opt) { fields->push_back(AnyView(*opt)); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<DLDevice> *opt) { fields->push_back(AnyView(*opt)); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<DLDataType> *opt) { fields->push_back(AnyView(*opt)); }
+    MLC_INLINE void operator()(MLCTypeField *, bool *v) { fields->push_back(AnyView(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, int8_t *v) { fields->push_back(AnyView(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, int16_t *v) { fields->push_back(AnyView(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, int32_t *v) { fields->push_back(AnyView(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, int64_t *v) { fields->push_back(AnyView(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, float *v) { fields->push_back(AnyView(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, double *v) { fields->push_back(AnyView(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, DLDataType *v) { fields->push_back(AnyView(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, DLDevice *v) { fields->push_back(AnyView(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<void *> *v) { fields->push_back(AnyView(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, void **v) { fields->push_back(AnyView(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, const char **v) { fields->push_back(AnyView(*v)); }
+
+    void HandleObject(const Object *obj) {
+      if (obj == nullptr) {
+        fields->push_back(AnyView());
+        return;
+      }
+      auto it = orig2new->find(obj);
+      if (it == orig2new->end()) {
+        MLC_THROW(InternalError) << "InternalError: object doesn't exist in the memo: " << AnyView(obj);
+      }
+      const Any &new_obj = it->second;
+      changed = changed || new_obj.type_index < kMLCStaticObjectBegin || new_obj.operator Object *() != obj;
+      fields->push_back(AnyView(new_obj));
+    }
+
+    void HandleAny(const Any *any) {
+      if (const Object *obj = any->TryCast<Object>()) {
+        HandleObject(obj);
+      } else {
+        fields->push_back(AnyView(*any));
+      }
+    }
+
+    const std::unordered_map<const Object *, Any> *orig2new;
+    std::vector<AnyView> *fields;
+    bool changed = false;
+  };
+  Remapper remapper{&orig2new, fields};
+  Any ret;
+  fields->clear();
+  if (UListObj *list = object->TryCast<UListObj>()) {
+    fields->reserve(list->size());
+    for (Any &e : *list) {
+      remapper.HandleAny(&e);
+    }
+    if (remapper.changed) {
+      UList::FromAnyTuple(static_cast<int32_t>(fields->size()), fields->data(), &ret);
+    }
+  } else if (UDictObj *dict = object->TryCast<UDictObj>()) {
+    for (auto [key, value] : *dict) {
+      remapper.HandleAny(&key);
+      remapper.HandleAny(&value);
+    }
+    if (remapper.changed) {
+      UDict::FromAnyTuple(static_cast<int32_t>(fields->size()), fields->data(), &ret);
+    }
+  } else {
+    VisitFields(object, type_info, remapper);
+    if (remapper.changed) {
+      FuncObj *init_func = Lib::_init(type_info->type_index);
+      ::mlc::base::FuncCall(init_func, static_cast<int32_t>(fields->size()), fields->data(), &ret);
+    }
+  }
+  if (!remapper.changed) {
+    ret = object;
+  }
+  return ret;
+}
+
+/****************** Hash-consing ******************/
+
+/*!
+ * \brief Maps structurally equal objects to a single canonical representative, keyed on the structural hash
+ * and confirmed by `StructuralEqual` without binding free variables. Objects in the table must not be mutated.
+ */
+struct HashConsTable {
+  HashConsTable() {
+    this->memo.assume_immutable = true;
+    this->memo.journal = &this->memo_inserted;
+  }
+
+  Object *Canonicalize(Object *obj) {
+    this->memo_inserted.clear();
+    uint64_t hash = StructuralHashImpl<Hash64>(obj, &this->memo);
+    Object *canon = this->FindOrInsert(hash, obj);
+    // Only representatives stay in the memo, which would otherwise keep every duplicate it has hashed alive
+    for (Object *inserted : this->memo_inserted) {
+      if (!this->IsRepresentative(inserted, this->memo.Find(inserted)->hash)) {
+        this->memo.Erase(inserted);
+      }
+    }
+    return canon;
+  }
+
+  Object *FindOrInsert(uint64_t hash, Object *obj) {
+    auto [begin, end] = this->buckets.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+      Object *candidate = it->second.get();
+      if (candidate == obj) {
+        return candidate;
+      }
+      try {
+        // Subtrees that share a free variable are still equal, e.g. two `x + 1` built from the same `x`
+        StructuralEqualImpl(candidate, obj, false, nullptr, true);
+        return candidate;
+      } catch (SEqualError &) {
+      }
+    }
+    this->buckets.emplace(hash, ObjectRef(obj));
+    return obj;
+  }
+
+  bool IsRepresentative(Object *obj, uint64_t hash) const {
+    auto [begin, end] = this->buckets.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+      if (it->second.get() == obj) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  Any Intern(AnyView source) {
+    if (::mlc::base::IsTypeIndexPOD(source.type_index)) {
+      return source;
+    }
+    // Objects that are never merged: those `StructuralEqual` cannot compare, tensors whose data it does not
+    // compare, and everything that refers to them
+    std::unordered_set<const Object *> opaque_objs;
+    std::unordered_map<const Object *, Any> orig2canon;
+    std::vector<AnyView> fields;
+    TopoVisit(source.operator Object *(), nullptr, [&](Object *object, MLCTypeInfo *type_info) mutable -> void {
+      bool is_container = object->IsInstance<UListObj>() || object->IsInstance<UDictObj>();
+      bool opaque = false;
+      Any ret;
+      if (object->IsInstance<StrObj>()) {
+        ret = object;
+      } else if (object->IsInstance<ErrorObj>() || object->IsInstance<FuncObj>() || object->IsInstance<TensorObj>() ||
+                 object->IsInstance<OpaqueObj>() || (type_info->structure_kind == 0 && !is_container)) {
+        ret = object;
+        opaque = true;
+      } else if (static_cast<StructureKind>(type_info->structure_kind) == StructureKind::kVar) {
+        // Variables are told apart by identity, so they are never rebuilt, e.g. to share a canonical name
+        ret = object;
+      } else {
+        // Rebuilds the object to refer to the canonical children
+        ret = RemapChildren(object, type_info, orig2canon, &fields);
+        for (const AnyView &field : fields) {
+          if (const Object *child = field.TryCast<Object>(); child != nullptr && opaque_objs.count(child)) {
+            opaque = true;
+            break;
+          }
+        }
+      }
+      Object *canon = ret.operator Object *();
+      if (opaque) {
+        opaque_objs.insert(canon);
+      } else {
+        canon = this->Canonicalize(canon);
+      }
+      orig2canon[object] = canon;
+    });
+    return orig2canon.at(source.operator Object *());
+  }
+
+  std::unordered_multimap<uint64_t, ObjectRef> buckets;
+  StructuralHashMemo<Hash64> memo;
+  std::vector<Object *> memo_inserted;
+  // Taken around each call through a handle, which may be shared across threads
+  std::mutex mutex;
+};
+
 /****************** Copy ******************/
 
+/*!
+ * \brief Re-creates in place each field of a byte-wise copy of an object that owns a reference, mapped through
+ * `orig2copy` if provided.
+ */
+struct ExternObjectCloner {
+  MLC_INLINE void operator()(MLCTypeField *field, Any *v) { Init<Any>(field, RemapAny(*v)); }
+  MLC_INLINE void operator()(MLCTypeField *field, ObjectRef *v) { Init<ObjectRef>(field, RemapObject(v->get())); }
+  MLC_INLINE void operator()(MLCTypeField *field, Optional<ObjectRef> *v) {
+    Init<Optional<ObjectRef>>(field, RemapObject(v->get()));
+  }
+  MLC_INLINE void operator()(MLCTypeField *field, Optional<bool> *v) { Init<Optional<bool>>(field, *v); }
+  MLC_INLINE void operator()(MLCTypeField *field, Optional<int64_t> *v) { Init<Optional<int64_t>>(field, *v); }
+  MLC_INLINE void operator()(MLCTypeField *field, Optional<double> *v) { Init<Optional<double>>(field, *v); }
+  MLC_INLINE void operator()(MLCTypeField *field, Optional<DLDevice> *v) { Init<Optional<DLDevice>>(field, *v); }
+  MLC_INLINE void operator()(MLCTypeField *field, Optional<DLDataType> *v) { Init<Optional<DLDataType>>(field, *v); }
+  MLC_INLINE void operator()(MLCTypeField *field, Optional<void *> *v) { Init<Optional<void *>>(field, *v); }
+  // Never called, as plain-old-data fields are not in the reference plan and are copied with the bytes
+  MLC_INLINE void operator()(MLCTypeField *, bool *) {}
+  MLC_INLINE void operator()(MLCTypeField *, int8_t *) {}
+  MLC_INLINE void operator()(MLCTypeField *, int16_t *) {}
+  MLC_INLINE void operator()(MLCTypeField *, int32_t *) {}
+  MLC_INLINE void operator()(MLCTypeField *, int64_t *) {}
+  MLC_INLINE void operator()(MLCTypeField *, float *) {}
+  MLC_INLINE void operator()(MLCTypeField *, double *) {}
+  MLC_INLINE void operator()(MLCTypeField *, void **) {}
+  MLC_INLINE void operator()(MLCTypeField *, DLDataType *) {}
+  MLC_INLINE void operator()(MLCTypeField *, DLDevice *) {}
+  MLC_INLINE void operator()(MLCTypeField *, const char **) {}
+
+  template <typename T, typename V> MLC_INLINE void Init(MLCTypeField *field, const V &value) {
+    // The destination holds the copied bytes of the source field, whose reference it does not own
+    new (WithOffset<T>(clone, field)) T(value);
+  }
+
+  AnyView RemapAny(AnyView v) const {
+    if (const Object *obj = v.TryCast<Object>()) {
+      return RemapObject(obj);
+    }
+    return v;
+  }
+
+  AnyView RemapObject(const Object *obj) const {
+    if (orig2copy == nullptr || obj == nullptr) {
+      return AnyView(obj);
+    } else if (auto it = orig2copy->find(obj); it != orig2copy->end()) {
+      return AnyView(it->second);
+    }
+    MLC_THROW(InternalError) << "InternalError: object doesn't exist in the memo: " << AnyView(obj);
+    MLC_UNREACHABLE();
+  }
+
+  Object *clone;
+  const std::unordered_map<const Object *, ObjectRef> *orig2copy;
+};
+
+/*!
+ * \brief Copies an instance of a Python-defined class without calling its `__init__`, which only assigns each
+ * field in turn.
+ */
+inline Any CloneExternObject(Object *source, MLCTypeInfo *type_info,
+                             const std::unordered_map<const Object *, ObjectRef> *orig2copy) {
+  int32_t num_bytes = ExternObjectNumBytes(source);
+  Object *clone = AllocExternObject(type_info->type_index, num_bytes);
+  Any ret(clone);
+  std::memcpy(reinterpret_cast<char *>(clone) + sizeof(MLCAny), reinterpret_cast<const char *>(source) + sizeof(MLCAny),
+              num_bytes - sizeof(MLCAny));
+  VisitFieldRefs(source, type_info, ExternObjectCloner{clone, orig2copy});
+  return ret;
+}
+
 inline Any CopyShallowImpl(AnyView source) {
   int32_t type_index = source.type_index;
   if (::mlc::base::IsTypeIndexPOD(type_index)) {
@@ -978,8 +1926,11 @@ inline Any CopyShallowImpl(AnyView source) {
     MLC_INLINE void operator()(MLCTypeField *, const char **v) { fields->push_back(AnyView(*v)); }
     std::vector<AnyView> *fields;
   };
-  FuncObj *init_func = Lib::_init(type_index);
   MLCTypeInfo *type_info = Lib::GetTypeInfo(type_index);
+  if (IsExternObject(source.operator Object *())) {
+    return CloneExternObject(source.operator Object *(), type_info, nullptr);
+  }
+  FuncObj *init_func = Lib::_init(type_index);
   std::vector<AnyView> fields;
   VisitFields(source.operator Object *(), type_info, Copier{&fields});
   Any ret;
@@ -1067,6 +2018,8 @@ inline Any CopyDeepImpl(AnyView source) {
       ret = object;
     } else if (object->IsInstance<OpaqueObj>()) {
       MLC_THROW(TypeError) << "Cannot copy `mlc.Opaque` of type: " << object->Cast<OpaqueObj>()->opaque_type_name;
+    } else if (IsExternObject(object)) {
+      ret = CloneExternObject(object, type_info, &orig2copy);
     } else {
       fields.clear();
       VisitFields(object, type_info, Copier{&orig2copy, &fields});
@@ -1078,6 +2031,35 @@ inline Any CopyDeepImpl(AnyView source) {
   return orig2copy.at(source.operator Object *());
 }
 
+/****************** Rewrite ******************/
+
+inline Any RewriteImpl(AnyView source, FuncObj *fn) {
+  if (::mlc::base::IsTypeIndexPOD(source.type_index)) {
+    return source;
+  }
+  std::unordered_map<const Object *, Any> orig2new;
+  std::vector<AnyView> fields;
+  TopoVisit(source.operator Object *(), nullptr, [&](Object *object, MLCTypeInfo *type_info) mutable -> void {
+    Any ret;
+    if (object->IsInstance<StrObj>()) {
+      // Strings are values rather than nodes, so `fn` is not called on them
+      orig2new[object] = object;
+      return;
+    } else if (object->IsInstance<ErrorObj>() || object->IsInstance<FuncObj>() || object->IsInstance<TensorObj>() ||
+               object->IsInstance<OpaqueObj>()) {
+      ret = object;
+    } else {
+      // Only ancestors of a rewritten node are rebuilt, with the rewritten children
+      ret = RemapChildren(object, type_info, orig2new, &fields);
+    }
+    AnyView arg = ret;
+    Any result;
+    ::mlc::base::FuncCall(fn, 1, &arg, &result);
+    orig2new[object] = std::move(result);
+  });
+  return orig2new.at(source.operator Object *());
+}
+
 /****************** Tensor <=> Bytes ******************/
 
 template <int N, typename T> union BytesUnion {
@@ -1116,9 +2098,8 @@ template <int N, typename T> T ReadElem(const uint8_t *data, int64_t *head, int6
   return v.v;
 }
 
-void WriteElemMany(uint8_t *data, int64_t *tail, uint8_t *ptr, int32_t elem_size, int64_t numel) {
-  uint8_t *start = data + *tail;
-  std::memcpy(start, ptr, elem_size * numel);
+/*! \brief Converts elements between native and little-endian byte order in place; a no-op on little-endian. */
+void SwapElemBytes(uint8_t *start, int32_t elem_size, int64_t numel) {
   if constexpr (kIsBigEndian) {
     if (elem_size > 1) { // we need to swap each element
       for (int64_t i = 0; i < numel; ++i, start += elem_size) {
@@ -1126,6 +2107,12 @@ void WriteElemMany(uint8_t *data, int64_t *tail, uint8_t *ptr, int32_t elem_size
       }
     }
   }
+}
+
+void WriteElemMany(uint8_t *data, int64_t *tail, uint8_t *ptr, int32_t elem_size, int64_t numel) {
+  uint8_t *start = data + *tail;
+  std::memcpy(start, ptr, elem_size * numel);
+  SwapElemBytes(start, elem_size, numel);
   *tail += static_cast<int64_t>(numel * elem_size);
 }
 
@@ -1137,28 +2124,25 @@ void ReadElemMany(const uint8_t *data, int64_t *head, int64_t max_size, uint8_t
   }
   std::memcpy(ptr, data + *head, elem_size * numel);
   *head = next_head;
-  if constexpr (kIsBigEndian) {
-    if (elem_size > 1) { // we need to swap each element
-      uint8_t *start = ptr;
-      for (int64_t i = 0; i < numel; ++i, start += elem_size) {
-        std::reverse(start, start + elem_size);
-      }
-    }
-  }
+  SwapElemBytes(ptr, elem_size, numel);
 }
 
 static const uint64_t kMLCTensorMagic = 0xDD5E40F096B4A13F;
 
-Str TensorToBytes(const DLTensor *src) {
+/*! \brief Number of bytes `TensorWriteBytes` writes before the raw data of a tensor with `ndim` dimensions. */
+constexpr int64_t TensorBytesHeaderSize(int32_t ndim) { return 8 + 4 + 4 + 8 * static_cast<int64_t>(ndim); }
+
+int64_t TensorBytesSize(const DLTensor *src) {
   if (src->device.device_type != kDLCPU || src->strides != nullptr) {
     MLC_THROW(ValueError) << "SaveDLPack: Only CPU tensor without strides is supported.";
   }
-  int32_t ndim = src->ndim;
-  int64_t numel = ::mlc::core::ShapeToNumel(ndim, src->shape);
+  int64_t numel = ::mlc::core::ShapeToNumel(src->ndim, src->shape);
   int32_t elem_size = ::mlc::base::DataTypeSize(src->dtype);
-  int64_t total_bytes = 8 + 4 + 4 + 8 * ndim + numel * elem_size;
-  Str ret(::mlc::core::StrPad::Allocator::NewWithPad<uint8_t>(total_bytes + 1, total_bytes));
-  uint8_t *data_ptr = reinterpret_cast<uint8_t *>(ret->data());
+  return TensorBytesHeaderSize(src->ndim) + numel * elem_size;
+}
+
+void TensorWriteBytesHeader(const DLTensor *src, uint8_t *data_ptr) {
+  int32_t ndim = src->ndim;
   int64_t tail = 0;
   WriteElem<8>(data_ptr, &tail, static_cast<uint64_t>(kMLCTensorMagic));
   WriteElem<4>(data_ptr, &tail, static_cast<uint32_t>(ndim));
@@ -1166,23 +2150,44 @@ Str TensorToBytes(const DLTensor *src) {
   for (int i = 0; i < ndim; ++i) {
     WriteElem<8>(data_ptr, &tail, src->shape[i]);
   }
+}
+
+void TensorWriteBytes(const DLTensor *src, uint8_t *data_ptr, int64_t total_bytes) {
+  int32_t ndim = src->ndim;
+  int64_t numel = ::mlc::core::ShapeToNumel(ndim, src->shape);
+  int32_t elem_size = ::mlc::base::DataTypeSize(src->dtype);
+  int64_t tail = TensorBytesHeaderSize(ndim);
+  TensorWriteBytesHeader(src, data_ptr);
   WriteElemMany(data_ptr, &tail, static_cast<uint8_t *>(src->data), elem_size, numel);
-  data_ptr[tail] = '\0';
   if (tail != total_bytes) {
     MLC_THROW(InternalError) << "SaveDLPack: Internal error in serialization.";
   }
+}
+
+Str TensorToBytes(const DLTensor *src) {
+  int64_t total_bytes = TensorBytesSize(src);
+  Str ret(::mlc::core::StrPad::Allocator::NewWithPad<uint8_t>(total_bytes + 1, total_bytes));
+  uint8_t *data_ptr = reinterpret_cast<uint8_t *>(ret->data());
+  TensorWriteBytes(src, data_ptr, total_bytes);
+  data_ptr[total_bytes] = '\0';
   return ret;
 }
 
-Tensor TensorFromBytes(const uint8_t *data_ptr, int64_t max_size) {
-  int64_t head = 0;
-  uint64_t header = ReadElem<8, uint64_t>(data_ptr, &head, max_size);
+/*!
+ * \brief Reads the header written by `TensorWriteBytesHeader` into a CPU tensor whose `data` is left to the caller
+ * and released by `deleter`. On return `*head` points to the first byte of the raw data.
+ */
+Tensor TensorFromBytesHeader(const uint8_t *data_ptr, int64_t *head, int64_t max_size, void (*deleter)(void *)) {
+  uint64_t header = ReadElem<8, uint64_t>(data_ptr, head, max_size);
   if (header != kMLCTensorMagic) {
     MLC_THROW(ValueError) << "LoadDLPack: Magic number mismatch.";
   }
-  int32_t ndim = ReadElem<4, int32_t>(data_ptr, &head, max_size);
-  Tensor ret = [ndim]() {
-    TensorObj *ret = ::mlc::DefaultObjectAllocator<TensorObj>::New();
+  int32_t ndim = ReadElem<4, int32_t>(data_ptr, head, max_size);
+  if (ndim < 0) {
+    MLC_THROW(ValueError) << "LoadDLPack: Invalid number of dimensions: " << ndim;
+  }
+  Tensor ret = [ndim, deleter]() {
+    TensorObj *ret = ::mlc::DefaultObjectAllocator<TensorObj>::NewOnHeap();
     ret->tensor.data = nullptr;
     ret->tensor.device = DLDevice{kDLCPU, 0};
     ret->tensor.ndim = ndim;
@@ -1191,86 +2196,674 @@ Tensor TensorFromBytes(const uint8_t *data_ptr, int64_t max_size) {
     ret->tensor.strides = nullptr;
     ret->tensor.byte_offset = 0;
     ret->manager_ctx = nullptr;
-    ret->_mlc_header.v.deleter = +[](void *_self) {
-      TensorObj *self = static_cast<TensorObj *>(_self);
-      uint8_t *data = static_cast<uint8_t *>(self->tensor.data);
-      delete[] data;
-      ::mlc::DefaultObjectAllocator<TensorObj>::Deleter(self);
-    };
+    ret->_mlc_header.v.deleter = deleter;
     return Tensor(ret);
   }();
   DLTensor *tensor = &ret->tensor;
-  tensor->dtype = ReadElem<4, DLDataType>(data_ptr, &head, max_size);
+  tensor->dtype = ReadElem<4, DLDataType>(data_ptr, head, max_size);
   for (int32_t i = 0; i < ndim; ++i) {
-    tensor->shape[i] = ReadElem<8, int64_t>(data_ptr, &head, max_size);
+    tensor->shape[i] = ReadElem<8, int64_t>(data_ptr, head, max_size);
   }
   tensor->shape[ndim] = -1;
+  return ret;
+}
+
+/*!
+ * \brief Returns the number of bytes of the raw data of a tensor read by `TensorFromBytesHeader`, after checking
+ * that its shape is valid and that the raw data fits in `max_bytes`, without overflowing.
+ */
+int64_t TensorDataBytesChecked(const DLTensor *tensor, int64_t max_bytes) {
+  int64_t num_bytes = ::mlc::base::DataTypeSize(tensor->dtype);
+  for (int32_t i = 0; i < tensor->ndim; ++i) {
+    if (tensor->shape[i] < 0) {
+      MLC_THROW(ValueError) << "LoadDLPack: Invalid shape, dimension " << i << " is " << tensor->shape[i];
+    } else if (tensor->shape[i] == 0) {
+      num_bytes = 0;
+    }
+  }
+  for (int32_t i = 0; i < tensor->ndim && num_bytes != 0; ++i) {
+    if (num_bytes > max_bytes / tensor->shape[i]) {
+      MLC_THROW(ValueError) << "LoadDLPack: Raw data is larger than the remaining " << max_bytes << " bytes";
+    }
+    num_bytes *= tensor->shape[i];
+  }
+  if (num_bytes > max_bytes) {
+    MLC_THROW(ValueError) << "LoadDLPack: Raw data is larger than the remaining " << max_bytes << " bytes";
+  }
+  return num_bytes;
+}
+
+/*!
+ * \brief Same as `TensorFromBytesHeader`, with `tensor.data` allocated for the raw data and owned by the tensor.
+ * The raw data must end by `data_end`, which is checked before allocating.
+ */
+Tensor TensorNewFromBytesHeader(const uint8_t *data_ptr, int64_t *head, int64_t max_size, int64_t data_end) {
+  Tensor ret = TensorFromBytesHeader(data_ptr, head, max_size, +[](void *_self) {
+    TensorObj *self = static_cast<TensorObj *>(_self);
+    uint8_t *data = static_cast<uint8_t *>(self->tensor.data);
+    delete[] data;
+    ::mlc::DefaultObjectAllocator<TensorObj>::Deleter(self);
+  });
+  DLTensor *tensor = &ret->tensor;
+  tensor->data = new uint8_t[TensorDataBytesChecked(tensor, data_end - *head)];
+  return ret;
+}
+
+Tensor TensorFromBytes(const uint8_t *data_ptr, int64_t max_size) {
+  int64_t head = 0;
+  Tensor ret = TensorNewFromBytesHeader(data_ptr, &head, max_size, max_size);
+  DLTensor *tensor = &ret->tensor;
   int32_t elem_size = ::mlc::base::DataTypeSize(tensor->dtype);
-  int64_t numel = ::mlc::core::ShapeToNumel(ndim, tensor->shape);
-  uint8_t *content = new uint8_t[numel * elem_size];
-  ReadElemMany(data_ptr, &head, max_size, content, elem_size, numel);
-  tensor->data = content;
+  int64_t numel = ::mlc::core::ShapeToNumel(tensor->ndim, tensor->shape);
+  ReadElemMany(data_ptr, &head, max_size, static_cast<uint8_t *>(tensor->data), elem_size, numel);
   return ret;
 }
 
-/****************** Serialize / Deserialize ******************/
+/****************** Streams ******************/
 
-inline mlc::Str Serialize(Any any) {
-  using mlc::base::TypeTraits;
-  std::vector<const char *> type_keys;
-  auto get_json_type_index = [type_key2index = std::unordered_map<const char *, int32_t>(),
-                              &type_keys](const char *type_key) mutable -> int32_t {
-    if (auto it = type_key2index.find(type_key); it != type_key2index.end()) {
-      return it->second;
+/*!
+ * \brief Destination of serialized bytes. Writers given a sink hand their buffer over every `kStreamChunkSize`
+ * bytes, so the memory a document takes stays bounded regardless of its size.
+ */
+using ByteSink = std::function<void(const char *data, int64_t size)>;
+constexpr int64_t kStreamChunkSize = int64_t(1) << 20;
+
+inline ByteSink FileDescriptorSink(int64_t fd) {
+  return [fd](const char *data, int64_t size) {
+    while (size > 0) {
+#ifdef _MSC_VER
+      int64_t n = ::_write(static_cast<int>(fd), data, static_cast<unsigned int>(std::min<int64_t>(size, 1 << 30)));
+#else
+      int64_t n = ::write(static_cast<int>(fd), data, static_cast<size_t>(size));
+#endif
+      if (n < 0 && errno == EINTR) {
+        continue;
+      } else if (n < 0) {
+        MLC_THROW(ValueError) << "Failed to write to file descriptor " << fd << ": " << std::strerror(errno);
+      }
+      data += n;
+      size -= n;
     }
-    int32_t type_index = static_cast<int32_t>(type_key2index.size());
-    type_key2index[type_key] = type_index;
-    type_keys.push_back(type_key);
-    return type_index;
   };
-  using TObj2Idx = std::unordered_map<Object *, int32_t>;
-  using TJsonTypeIndex = decltype(get_json_type_index);
-  struct Emitter {
-    MLC_INLINE void operator()(MLCTypeField *, const Any *any) { EmitAny(any); }
-    // clang-format off
-    MLC_INLINE void operator()(MLCTypeField *, ObjectRef *obj) { if (Object *v = obj->get()) EmitObject(v); else EmitNil(); }
-    MLC_INLINE void operator()(MLCTypeField *, Optional<ObjectRef> *opt) { if (Object *v = opt->get()) EmitObject(v); else EmitNil(); }
-    MLC_INLINE void operator()(MLCTypeField *, Optional<bool> *opt) { if (const bool *v = opt->get()) EmitBool(*v); else EmitNil(); }
-    MLC_INLINE void operator()(MLCTypeField *, Optional<int64_t> *opt) { if (const int64_t *v = opt->get()) EmitInt(*v); else EmitNil(); }
-    MLC_INLINE void operator()(MLCTypeField *, Optional<double> *opt) { if (const double *v = opt->get())  EmitFloat(*v); else EmitNil(); }
-    MLC_INLINE void operator()(MLCTypeField *, Optional<DLDevice> *opt) { if (const DLDevice *v = opt->get()) EmitDevice(*v); else EmitNil(); }
-    MLC_INLINE void operator()(MLCTypeField *, Optional<DLDataType> *opt) { if (const DLDataType *v = opt->get()) EmitDType(*v); else EmitNil(); }
-    // clang-format on
-    MLC_INLINE void operator()(MLCTypeField *, bool *v) { EmitBool(*v); }
-    MLC_INLINE void operator()(MLCTypeField *, int8_t *v) { EmitInt(static_cast<int64_t>(*v)); }
-    MLC_INLINE void operator()(MLCTypeField *, int16_t *v) { EmitInt(static_cast<int64_t>(*v)); }
-    MLC_INLINE void operator()(MLCTypeField *, int32_t *v) { EmitInt(static_cast<int64_t>(*v)); }
-    MLC_INLINE void operator()(MLCTypeField *, int64_t *v) { EmitInt(static_cast<int64_t>(*v)); }
-    MLC_INLINE void operator()(MLCTypeField *, float *v) { EmitFloat(static_cast<double>(*v)); }
-    MLC_INLINE void operator()(MLCTypeField *, double *v) { EmitFloat(static_cast<double>(*v)); }
-    MLC_INLINE void operator()(MLCTypeField *, DLDataType *v) { EmitDType(*v); }
-    MLC_INLINE void operator()(MLCTypeField *, DLDevice *v) { EmitDevice(*v); }
-    MLC_INLINE void operator()(MLCTypeField *, Optional<void *> *) {
-      MLC_THROW(TypeError) << "Unserializable type: void *";
+}
+
+inline ByteSink CFileSink(std::FILE *fp) {
+  return [fp](const char *data, int64_t size) {
+    if (std::fwrite(data, 1, static_cast<size_t>(size), fp) != static_cast<size_t>(size)) {
+      MLC_THROW(ValueError) << "Failed to write to FILE*: " << std::strerror(errno);
+    }
+  };
+}
+
+/*! \brief Calls `func(data: Ptr, size: int)` for each chunk; the pointer is only valid during the call. */
+inline ByteSink FuncSink(FuncObj *func) {
+  return [func](const char *data, int64_t size) {
+    AnyView args[2] = {AnyView(static_cast<void *>(const_cast<char *>(data))), AnyView(size)};
+    Any ret;
+    ::mlc::base::FuncCall(func, 2, args, &ret);
+  };
+}
+
+inline ByteSink ToByteSink(AnyView sink) {
+  if (sink.type_index == kMLCInt) {
+    return FileDescriptorSink(sink.operator int64_t());
+  } else if (sink.type_index == kMLCPtr) {
+    return CFileSink(static_cast<std::FILE *>(sink.operator void *()));
+  } else if (sink.type_index == kMLCFunc) {
+    return FuncSink(sink.operator FuncObj *());
+  }
+  MLC_THROW(TypeError) << "Expected a file descriptor (int), a `FILE *` (Ptr) or a callback (Func) as sink, but got: "
+                       << sink;
+  MLC_UNREACHABLE();
+}
+
+/*!
+ * \brief A readable file descriptor, read at explicit offsets. Reads do not move its file position, except on
+ * Windows, where they seek and the position is restored afterwards.
+ */
+struct FileDescriptorSource {
+  int64_t Size() const {
+#ifdef _MSC_VER
+    struct _stat64 st;
+    int rc = ::_fstat64(static_cast<int>(fd), &st);
+#else
+    struct stat st;
+    int rc = ::fstat(static_cast<int>(fd), &st);
+#endif
+    if (rc != 0) {
+      MLC_THROW(ValueError) << "Failed to stat file descriptor " << fd << ": " << std::strerror(errno);
+    }
+    return static_cast<int64_t>(st.st_size);
+  }
+
+  void ReadAt(int64_t offset, uint8_t *data, int64_t size) const {
+#ifdef _MSC_VER
+    struct PositionGuard {
+      ~PositionGuard() {
+        if (pos >= 0) {
+          ::_lseeki64(fd, pos, SEEK_SET);
+        }
+      }
+      int fd;
+      int64_t pos;
+    } guard{static_cast<int>(fd), ::_telli64(static_cast<int>(fd))};
+#endif
+    while (size > 0) {
+#ifdef _MSC_VER
+      int64_t n = ::_lseeki64(static_cast<int>(fd), offset, SEEK_SET) < 0
+                      ? -1
+                      : ::_read(static_cast<int>(fd), data, static_cast<unsigned int>(std::min<int64_t>(size, 1 << 30)));
+#else
+      int64_t n = ::pread(static_cast<int>(fd), data, static_cast<size_t>(size), static_cast<off_t>(offset));
+#endif
+      if (n < 0 && errno == EINTR) {
+        continue;
+      } else if (n < 0) {
+        MLC_THROW(ValueError) << "Failed to read from file descriptor " << fd << ": " << std::strerror(errno);
+      } else if (n == 0) {
+        MLC_THROW(ValueError) << "Unexpected EOF when reading file descriptor " << fd << " at byte " << offset;
+      }
+      offset += n;
+      data += n;
+      size -= n;
+    }
+  }
+
+  int64_t fd;
+};
+
+/*! \brief Alignment of the raw data of tensors in binary documents and tensor files, from the start of the file. */
+constexpr int64_t kMLCBinaryTensorAlign = 64;
+
+/*! \brief Writes bytes into `buf`, which is handed over to `sink` in chunks if one is given. */
+struct BinaryWriter {
+  void PutByte(uint8_t v) { buf.push_back(static_cast<char>(v)); }
+  void PutVarint(uint64_t v) {
+    for (; v >= 0x80; v >>= 7) {
+      PutByte(static_cast<uint8_t>(v | 0x80));
+    }
+    PutByte(static_cast<uint8_t>(v));
+  }
+  void PutBytes(const char *data, int64_t length) {
+    PutVarint(static_cast<uint64_t>(length));
+    buf.append(data, static_cast<size_t>(length));
+  }
+  template <int N, typename T> void PutFixed(T v) {
+    int64_t pos = Reserve(N);
+    WriteElem<N>(reinterpret_cast<uint8_t *>(&buf[0]), &pos, v);
+  }
+  int64_t Reserve(int64_t n) {
+    int64_t pos = static_cast<int64_t>(buf.size());
+    buf.resize(buf.size() + static_cast<size_t>(n));
+    return pos;
+  }
+  /*! \brief Writes `TensorToBytes(src)` chunk by chunk. */
+  void PutTensorBytes(const DLTensor *src) {
+    int64_t pos = Reserve(TensorBytesHeaderSize(src->ndim));
+    TensorWriteBytesHeader(src, reinterpret_cast<uint8_t *>(&buf[pos]));
+    uint8_t *data = static_cast<uint8_t *>(src->data);
+    int32_t elem_size = ::mlc::base::DataTypeSize(src->dtype);
+    int64_t numel = ::mlc::core::ShapeToNumel(src->ndim, src->shape);
+    int64_t chunk_numel = std::max<int64_t>(1, kStreamChunkSize / elem_size);
+    for (int64_t i = 0; i < numel; i += chunk_numel) {
+      int64_t n = std::min(chunk_numel, numel - i);
+      int64_t tail = Reserve(n * elem_size);
+      WriteElemMany(reinterpret_cast<uint8_t *>(&buf[0]), &tail, data + i * elem_size, elem_size, n);
+      MaybeFlush();
+    }
+  }
+  /*! \brief Position in the document, counting the bytes already handed over to `sink`. */
+  int64_t Tell() const { return flushed + static_cast<int64_t>(buf.size()); }
+  void MaybeFlush() {
+    if (sink != nullptr && static_cast<int64_t>(buf.size()) >= kStreamChunkSize) {
+      Flush();
+    }
+  }
+  void Flush() {
+    if (!buf.empty()) {
+      (*sink)(buf.data(), static_cast<int64_t>(buf.size()));
+      flushed += static_cast<int64_t>(buf.size());
+      buf.clear();
+    }
+  }
+  std::string buf;
+  const ByteSink *sink = nullptr;
+  int64_t flushed = 0;
+};
+
+/*!
+ * \brief A copy-on-write memory mapping of a whole file, shared by reference between its users, such as the
+ * tensors that view into it. Writes through the mapping never reach the file.
+ */
+struct MappedFile {
+  static MappedFile *Open(const char *path) {
+    std::unique_ptr<MappedFile> ret = std::make_unique<MappedFile>();
+#ifdef _MSC_VER
+    ret->file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    LARGE_INTEGER size;
+    if (ret->file == INVALID_HANDLE_VALUE || !::GetFileSizeEx(ret->file, &size)) {
+      MLC_THROW(ValueError) << "Failed to open file: " << path;
+    }
+    ret->size = static_cast<int64_t>(size.QuadPart);
+    if (ret->size > 0) {
+      ret->mapping = ::CreateFileMappingA(ret->file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+      void *addr = ret->mapping == nullptr ? nullptr : ::MapViewOfFile(ret->mapping, FILE_MAP_COPY, 0, 0, 0);
+      if (addr == nullptr) {
+        MLC_THROW(ValueError) << "Failed to memory-map file: " << path;
+      }
+      ret->data = static_cast<uint8_t *>(addr);
+    }
+#else
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+      MLC_THROW(ValueError) << "Failed to open file: " << path << ": " << std::strerror(errno);
+    }
+    ret->size = FileDescriptorSource{fd}.Size();
+    if (ret->size > 0) {
+      void *addr = ::mmap(nullptr, static_cast<size_t>(ret->size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if (addr == MAP_FAILED) {
+        int error = errno;
+        ::close(fd);
+        MLC_THROW(ValueError) << "Failed to memory-map file: " << path << ": " << std::strerror(error);
+      }
+      ret->data = static_cast<uint8_t *>(addr);
+    }
+    ::close(fd);
+#endif
+    return ret.release();
+  }
+
+  ~MappedFile() {
+#ifdef _MSC_VER
+    if (data != nullptr) {
+      ::UnmapViewOfFile(data);
+    }
+    if (mapping != nullptr) {
+      ::CloseHandle(mapping);
+    }
+    if (file != INVALID_HANDLE_VALUE) {
+      ::CloseHandle(file);
+    }
+#else
+    if (data != nullptr) {
+      ::munmap(data, static_cast<size_t>(size));
+    }
+#endif
+  }
+
+  void IncRef() { ref_count.fetch_add(1, std::memory_order_relaxed); }
+  void DecRef() {
+    if (ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+  uint8_t *data = nullptr;
+  int64_t size = 0;
+  std::atomic<int64_t> ref_count{1};
+#ifdef _MSC_VER
+  HANDLE file = INVALID_HANDLE_VALUE;
+  HANDLE mapping = nullptr;
+#endif
+};
+
+/*!
+ * \brief A tensor for the `TensorToBytes` layout of `num_bytes` at `offset` in `file`, whose data points into the
+ * mapping, which the tensor keeps alive through `manager_ctx`.
+ */
+Tensor MappedFileTensor(MappedFile *file, int64_t offset, int64_t num_bytes) {
+  if (offset < 0 || num_bytes < 0 || num_bytes > file->size - offset) {
+    MLC_THROW(ValueError) << "Tensor of " << num_bytes << " bytes at offset " << offset
+                          << " is out of the bounds of the mapped file of " << file->size << " bytes";
+  }
+  const uint8_t *data_ptr = file->data + offset;
+  if constexpr (kIsBigEndian) { // The raw data is little-endian, which requires a copy to swap bytes
+    return TensorFromBytes(data_ptr, num_bytes);
+  }
+  int64_t head = 0;
+  Tensor ret = TensorFromBytesHeader(data_ptr, &head, num_bytes, +[](void *_self) {
+    TensorObj *self = static_cast<TensorObj *>(_self);
+    if (self->manager_ctx != nullptr) {
+      static_cast<MappedFile *>(self->manager_ctx)->DecRef();
+    }
+    ::mlc::DefaultObjectAllocator<TensorObj>::Deleter(self);
+  });
+  DLTensor *tensor = &ret->tensor;
+  if (head + TensorDataBytesChecked(tensor, num_bytes - head) != num_bytes) {
+    MLC_THROW(ValueError) << "Corrupted tensor at offset " << offset << " of the mapped file";
+  }
+  tensor->data = file->data + offset + head;
+  file->IncRef();
+  ret->manager_ctx = file;
+  return ret;
+}
+
+/****************** Parallel ******************/
+
+/*!
+ * \brief Runs the items of a batch on a fixed set of worker threads together with the calling thread. Workers
+ * live as long as the process, so that their thread-local scratch state is reused across batches. Leaked on
+ * purpose so that it outlives all other static objects.
+ */
+struct WorkerPool {
+  static WorkerPool *Global() {
+    static WorkerPool *instance = new WorkerPool();
+    return instance;
+  }
+
+  void ParallelFor(int64_t num_items, const std::function<void(int64_t)> &body) {
+    if (this->num_workers == 0 || num_items <= 1) {
+      for (int64_t i = 0; i < num_items; ++i) {
+        body(i);
+      }
+      return;
+    }
+    // Batches submitted from different threads take turns
+    std::lock_guard<std::mutex> batch_lock(this->batch_mutex);
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->body = &body;
+      this->num_items = num_items;
+      this->next_item.store(0, std::memory_order_relaxed);
+      this->error = nullptr;
+      this->num_running = this->num_workers;
+      ++this->generation;
+    }
+    this->cv_work.notify_all();
+    this->RunItems();
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->cv_done.wait(lock, [this]() { return this->num_running == 0; });
+    this->body = nullptr;
+    if (this->error) {
+      std::exception_ptr error = nullptr;
+      std::swap(error, this->error);
+      std::rethrow_exception(error);
+    }
+  }
+
+private:
+  WorkerPool() {
+    unsigned int num_threads = std::thread::hardware_concurrency();
+    this->num_workers = num_threads > 1 ? static_cast<int64_t>(num_threads) - 1 : 0;
+    for (int64_t i = 0; i < this->num_workers; ++i) {
+      std::thread([this]() { this->Run(); }).detach();
+    }
+  }
+
+  void RunItems() {
+    for (int64_t i; (i = this->next_item.fetch_add(1, std::memory_order_relaxed)) < this->num_items;) {
+      try {
+        (*this->body)(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->error) {
+          this->error = std::current_exception();
+        }
+        // Skips the remaining items
+        this->next_item.store(this->num_items, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void Run() {
+#if MLC_BIASED_REFCOUNT == 1
+    // Workers hand their objects over to the submitting thread and may then sit idle for long, so objects dropped
+    // elsewhere cannot wait for them to merge
+    ::mlc::base::BiasedDisown();
+#endif
+    uint64_t seen_generation = 0;
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true) {
+      this->cv_work.wait(lock, [&]() { return this->generation != seen_generation; });
+      seen_generation = this->generation;
+      lock.unlock();
+      this->RunItems();
+      lock.lock();
+      if (--this->num_running == 0) {
+        this->cv_done.notify_one();
+      }
+    }
+  }
+
+  std::mutex batch_mutex;
+  std::mutex mutex;
+  std::condition_variable cv_work;
+  std::condition_variable cv_done;
+  const std::function<void(int64_t)> *body = nullptr;
+  int64_t num_items = 0;
+  std::atomic<int64_t> next_item{0};
+  std::exception_ptr error = nullptr;
+  int64_t num_workers = 0;
+  int64_t num_running = 0;
+  uint64_t generation = 0;
+};
+
+/****************** Serialize / Deserialize ******************/
+
+/*!
+ * \brief A growable byte buffer that `Serialize` appends JSON text to, handed over to `Str` without a copy,
+ * or to `sink` chunk by chunk when streaming.
+ */
+struct JSONWriter {
+  void Put(char c) { buf.push_back(c); }
+  void Put(std::string_view s) { buf.append(s.data(), s.size()); }
+
+  void MaybeFlush() {
+    if (sink != nullptr && static_cast<int64_t>(buf.size()) >= kStreamChunkSize) {
+      Flush();
+    }
+  }
+
+  void Flush() {
+    if (!buf.empty()) {
+      (*sink)(buf.data(), static_cast<int64_t>(buf.size()));
+      buf.clear();
+    }
+  }
+
+  void PutInt(int64_t v) {
+    char digits[20];
+    char *end = digits + sizeof(digits);
+    char *p = end;
+    uint64_t u = v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+    do {
+      *--p = static_cast<char>('0' + u % 10);
+      u /= 10;
+    } while (u != 0);
+    if (v < 0) {
+      *--p = '-';
+    }
+    buf.append(p, static_cast<size_t>(end - p));
+  }
+
+  /*!
+   * \brief Writes the shortest decimal that parses back to `v`. It always carries a '.' or an exponent,
+   * because `Deserialize` reads bare integers as references to earlier values.
+   */
+  void PutFloat(double v) {
+    char digits[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    size_t n = static_cast<size_t>(std::to_chars(digits, digits + sizeof(digits), v).ptr - digits);
+#else
+    size_t n = 0;
+    for (int32_t precision = 15; precision <= 17; ++precision) {
+      n = static_cast<size_t>(std::snprintf(digits, sizeof(digits), "%.*g", precision, v));
+      if (std::strtod(digits, nullptr) == v) {
+        break;
+      }
+    }
+#endif
+    buf.append(digits, n);
+    auto is_float_mark = [](char c) { return c == '.' || c == 'e'; };
+    if (std::isfinite(v) && std::none_of(digits, digits + n, is_float_mark)) {
+      buf.append(".0");
+    }
+  }
+
+  void PutStr(const char *data, int64_t length) {
+    // Most strings are plain ASCII without escapes, which are copied verbatim
+    for (int64_t i = 0; i < length; ++i) {
+      unsigned char c = static_cast<unsigned char>(data[i]);
+      if (c == '"' || c == '\\' || c == '\n' || c == '\t' || c == '\r' || c == '\x1b' || c >= 0x80) {
+        std::ostringstream os;
+        StrObj::PrintEscape(data, length, os);
+        Put(os.str());
+        return;
+      }
+    }
+    buf.reserve(buf.size() + static_cast<size_t>(length) + 2);
+    buf.push_back('"');
+    buf.append(data, static_cast<size_t>(length));
+    buf.push_back('"');
+  }
+
+  /*! \brief Writes `Base64Encode(TensorToBytes(src))` chunk by chunk, without materializing either. */
+  void PutTensorBase64(const DLTensor *src) {
+    TensorBytesSize(src); // validates that `src` is a contiguous CPU tensor
+    uint8_t pending[3];
+    int64_t num_pending = 0;
+    auto feed = [this, &pending, &num_pending](const uint8_t *data, int64_t len) {
+      for (; num_pending > 0 && num_pending < 3 && len > 0; --len) {
+        pending[num_pending++] = *data++;
+      }
+      if (num_pending == 3) {
+        PutBase64Groups(pending, 3);
+        num_pending = 0;
+      }
+      int64_t len_groups = len / 3 * 3;
+      PutBase64Groups(data, len_groups);
+      for (int64_t i = len_groups; i < len; ++i) {
+        pending[num_pending++] = data[i];
+      }
+    };
+    std::vector<uint8_t> chunk(static_cast<size_t>(TensorBytesHeaderSize(src->ndim)));
+    TensorWriteBytesHeader(src, chunk.data());
+    feed(chunk.data(), static_cast<int64_t>(chunk.size()));
+    const uint8_t *data = static_cast<const uint8_t *>(src->data);
+    int32_t elem_size = ::mlc::base::DataTypeSize(src->dtype);
+    int64_t numel = ::mlc::core::ShapeToNumel(src->ndim, src->shape);
+    int64_t chunk_numel = std::max<int64_t>(1, kStreamChunkSize / 4 * 3 / elem_size);
+    for (int64_t i = 0; i < numel; i += chunk_numel) {
+      int64_t n = std::min(chunk_numel, numel - i);
+      const uint8_t *elems = data + i * elem_size;
+      if constexpr (kIsBigEndian) {
+        int64_t tail = 0;
+        chunk.resize(static_cast<size_t>(n * elem_size));
+        WriteElemMany(chunk.data(), &tail, const_cast<uint8_t *>(elems), elem_size, n);
+        elems = chunk.data();
+      }
+      feed(elems, n * elem_size);
+    }
+    if (num_pending > 0) {
+      size_t pos = buf.size();
+      buf.resize(pos + 4);
+      Base64EncodeTail(pending, num_pending, reinterpret_cast<uint8_t *>(&buf[pos]));
+    }
+  }
+
+  void PutBase64Groups(const uint8_t *data, int64_t len) {
+    size_t pos = buf.size();
+    buf.resize(pos + static_cast<size_t>(len / 3 * 4));
+    Base64EncodeGroups(data, len, reinterpret_cast<uint8_t *>(&buf[pos]));
+    MaybeFlush();
+  }
+
+  /*!
+   * \brief Writes `TensorToBytes(src)` into `tensor_file`, padded so that the raw data is aligned to
+   * `kMLCBinaryTensorAlign` bytes, and refers to it as `[offset, nbytes]`.
+   */
+  void PutTensorFileEntry(const DLTensor *src) {
+    int64_t num_bytes = TensorBytesSize(src);
+    int64_t data_begin = tensor_file->Tell() + TensorBytesHeaderSize(src->ndim);
+    tensor_file->Reserve((kMLCBinaryTensorAlign - data_begin % kMLCBinaryTensorAlign) % kMLCBinaryTensorAlign);
+    int64_t offset = tensor_file->Tell();
+    tensor_file->PutTensorBytes(src);
+    Put('[');
+    PutInt(offset);
+    Put(", ");
+    PutInt(num_bytes);
+    Put(']');
+  }
+
+  std::string buf;
+  const ByteSink *sink = nullptr;
+  /*! \brief If set, tensors are stored in this file as raw bytes rather than inline as base64. */
+  BinaryWriter *tensor_file = nullptr;
+};
+
+inline void Serialize(Any any, JSONWriter *writer) {
+  using mlc::base::TypeTraits;
+  JSONWriter &out = *writer;
+  std::vector<const char *> type_keys;
+  auto get_json_type_index = [type_key2index = std::unordered_map<const char *, int32_t>(),
+                              &type_keys](const char *type_key) mutable -> int32_t {
+    if (auto it = type_key2index.find(type_key); it != type_key2index.end()) {
+      return it->second;
+    }
+    int32_t type_index = static_cast<int32_t>(type_key2index.size());
+    type_key2index[type_key] = type_index;
+    type_keys.push_back(type_key);
+    return type_index;
+  };
+  using TObj2Idx = std::unordered_map<Object *, int32_t>;
+  using TJsonTypeIndex = decltype(get_json_type_index);
+  struct Emitter {
+    MLC_INLINE void operator()(MLCTypeField *, const Any *any) { EmitAny(any); }
+    // clang-format off
+    MLC_INLINE void operator()(MLCTypeField *, ObjectRef *obj) { if (Object *v = obj->get()) EmitObject(v); else EmitNil(); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<ObjectRef> *opt) { if (Object *v = opt->get()) EmitObject(v); else EmitNil(); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<bool> *opt) { if (const bool *v = opt->get()) EmitBool(*v); else EmitNil(); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<int64_t> *opt) { if (const int64_t *v = opt->get()) EmitInt(*v); else EmitNil(); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<double> *opt) { if (const double *v = opt->get())  EmitFloat(*v); else EmitNil(); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<DLDevice> *opt) { if (const DLDevice *v = opt->get()) EmitDevice(*v); else EmitNil(); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<DLDataType> *opt) { if (const DLDataType *v = opt->get()) EmitDType(*v); else EmitNil(); }
+    // clang-format on
+    MLC_INLINE void operator()(MLCTypeField *, bool *v) { EmitBool(*v); }
+    MLC_INLINE void operator()(MLCTypeField *, int8_t *v) { EmitInt(static_cast<int64_t>(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, int16_t *v) { EmitInt(static_cast<int64_t>(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, int32_t *v) { EmitInt(static_cast<int64_t>(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, int64_t *v) { EmitInt(static_cast<int64_t>(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, float *v) { EmitFloat(static_cast<double>(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, double *v) { EmitFloat(static_cast<double>(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, DLDataType *v) { EmitDType(*v); }
+    MLC_INLINE void operator()(MLCTypeField *, DLDevice *v) { EmitDevice(*v); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<void *> *) {
+      MLC_THROW(TypeError) << "Unserializable type: void *";
     }
     MLC_INLINE void operator()(MLCTypeField *, void **) { MLC_THROW(TypeError) << "Unserializable type: void *"; }
     MLC_INLINE void operator()(MLCTypeField *, const char **) {
       MLC_THROW(TypeError) << "Unserializable type: const char *";
     }
-    inline void EmitNil() { (*os) << ", null"; }
-    inline void EmitBool(bool v) { (*os) << ", " << (v ? "true" : "false"); }
-    inline void EmitFloat(double v) { (*os) << ", " << std::fixed << std::setprecision(19) << v; }
+    inline void EmitNil() { out->Put(", null"); }
+    inline void EmitBool(bool v) { out->Put(v ? ", true" : ", false"); }
+    inline void EmitFloat(double v) {
+      out->Put(", ");
+      out->PutFloat(v);
+    }
     inline void EmitInt(int64_t v) {
       int32_t type_int = (*get_json_type_index)(TypeTraits<int64_t>::type_str);
-      (*os) << ", [" << type_int << ", " << v << "]";
+      out->Put(", [");
+      out->PutInt(type_int);
+      out->Put(", ");
+      out->PutInt(v);
+      out->Put(']');
     }
     inline void EmitDevice(DLDevice v) {
       int32_t type_device = (*get_json_type_index)(TypeTraits<DLDevice>::type_str);
-      (*os) << ", [" << type_device << ", " << ::mlc::base::TypeTraits<DLDevice>::__str__(v) << "]";
+      out->Put(", [");
+      out->PutInt(type_device);
+      out->Put(", \"");
+      out->Put(::mlc::base::TypeTraits<DLDevice>::__str__(v));
+      out->Put("\"]");
     }
     inline void EmitDType(DLDataType v) {
       int32_t type_dtype = (*get_json_type_index)(TypeTraits<DLDataType>::type_str);
-      (*os) << ", [" << type_dtype << ", " << ::mlc::base::TypeTraits<DLDataType>::__str__(v) << "]";
+      out->Put(", [");
+      out->PutInt(type_dtype);
+      out->Put(", \"");
+      out->Put(::mlc::base::TypeTraits<DLDataType>::__str__(v));
+      out->Put("\"]");
     }
     inline void EmitAny(const Any *any) {
       int32_t type_index = any->type_index;
@@ -1286,6 +2879,9 @@ inline mlc::Str Serialize(Any any) {
         EmitDevice(any->operator DLDevice());
       } else if (type_index == kMLCDataType) {
         EmitDType(any->operator DLDataType());
+      } else if (type_index == kMLCSmallStr) {
+        out->Put(", ");
+        out->PutStr(any->v.v_bytes, any->small_len);
       } else if (type_index >= kMLCStaticObjectBegin) {
         EmitObject(any->operator Object *());
       } else {
@@ -1300,46 +2896,51 @@ inline mlc::Str Serialize(Any any) {
       if (obj_idx == -1) {
         MLC_THROW(InternalError) << "This should never happen: topological ordering violated";
       }
-      (*os) << ", " << obj_idx;
+      out->Put(", ");
+      out->PutInt(obj_idx);
     }
-    std::ostringstream *os;
+    JSONWriter *out;
     TJsonTypeIndex *get_json_type_index;
     const TObj2Idx *obj2index;
   };
 
   std::unordered_map<Object *, int32_t> topo_indices;
   std::vector<TensorObj *> tensors;
-  std::ostringstream os;
-  auto on_visit = [&topo_indices, get_json_type_index = &get_json_type_index, os = &os, &tensors,
+  auto on_visit = [&topo_indices, get_json_type_index = &get_json_type_index, out = &out, &tensors,
                    is_first_object = true](Object *object, MLCTypeInfo *type_info) mutable -> void {
+    out->MaybeFlush();
     int32_t &topo_index = topo_indices[object];
     if (topo_index == 0) {
       topo_index = static_cast<int32_t>(topo_indices.size()) - 1;
     } else {
       MLC_THROW(InternalError) << "This should never happen: object already visited";
     }
-    Emitter emitter{os, get_json_type_index, &topo_indices};
+    Emitter emitter{out, get_json_type_index, &topo_indices};
     if (is_first_object) {
       is_first_object = false;
     } else {
-      os->put(',');
+      out->Put(',');
     }
     if (StrObj *str = object->TryCast<StrObj>()) {
-      str->PrintEscape(*os);
+      out->PutStr(str->data(), str->size());
       return;
     }
-    (*os) << '[' << (*get_json_type_index)(type_info->type_key);
+    out->Put('[');
+    out->PutInt((*get_json_type_index)(type_info->type_key));
     if (UListObj *list = object->TryCast<UListObj>()) {
       for (Any &any : *list) {
         emitter(nullptr, &any);
+        out->MaybeFlush();
       }
     } else if (UDictObj *dict = object->TryCast<UDictObj>()) {
       for (auto &kv : *dict) {
         emitter(nullptr, &kv.first);
         emitter(nullptr, &kv.second);
+        out->MaybeFlush();
       }
     } else if (TensorObj *tensor = object->TryCast<TensorObj>()) {
-      (*os) << ", " << tensors.size();
+      out->Put(", ");
+      out->PutInt(static_cast<int64_t>(tensors.size()));
       tensors.push_back(tensor);
     } else if (object->IsInstance<FuncObj>() || object->IsInstance<ErrorObj>()) {
       MLC_THROW(TypeError) << "Unserializable type: " << object->GetTypeKey();
@@ -1348,66 +2949,265 @@ inline mlc::Str Serialize(Any any) {
     } else {
       VisitFields(object, type_info, emitter);
     }
-    os->put(']');
+    out->Put(']');
   };
-  os << "{\"values\": [";
+  out.Put("{\"values\": [");
   if (any.type_index >= kMLCStaticObjectBegin) { // Topological the objects according to dependency
     TopoVisit(any.operator Object *(), nullptr, on_visit);
   } else if (any.type_index == kMLCNone) {
-    os << "null";
+    out.Put("null");
   } else if (any.type_index == kMLCBool) {
     bool v = any.operator bool();
-    os << (v ? "true" : "false");
+    out.Put(v ? "true" : "false");
   } else if (any.type_index == kMLCInt) {
     int32_t type_int = get_json_type_index(TypeTraits<int64_t>::type_str);
     int64_t v = any;
-    os << "[" << type_int << ", " << v << "]";
+    out.Put('[');
+    out.PutInt(type_int);
+    out.Put(", ");
+    out.PutInt(v);
+    out.Put(']');
   } else if (any.type_index == kMLCFloat) {
     double v = any;
-    os << v;
+    out.PutFloat(v);
   } else if (any.type_index == kMLCDevice) {
     int32_t type_device = get_json_type_index(TypeTraits<DLDevice>::type_str);
     DLDevice v = any;
-    os << "[" << type_device << ", \"" << TypeTraits<DLDevice>::__str__(v) << "\"]";
+    out.Put('[');
+    out.PutInt(type_device);
+    out.Put(", \"");
+    out.Put(TypeTraits<DLDevice>::__str__(v));
+    out.Put("\"]");
   } else if (any.type_index == kMLCDataType) {
     int32_t type_dtype = get_json_type_index(TypeTraits<DLDataType>::type_str);
     DLDataType v = any;
-    os << "[" << type_dtype << ", \"" << TypeTraits<DLDataType>::__str__(v) << "\"]";
+    out.Put('[');
+    out.PutInt(type_dtype);
+    out.Put(", \"");
+    out.Put(TypeTraits<DLDataType>::__str__(v));
+    out.Put("\"]");
+  } else if (any.type_index == kMLCSmallStr) {
+    out.PutStr(any.v.v_bytes, any.small_len);
   } else {
     MLC_THROW(TypeError) << "Cannot serialize type: " << Lib::GetTypeKey(any.type_index);
   }
-  os << "], \"type_keys\": [";
+  out.Put("], \"type_keys\": [");
   for (size_t i = 0; i < type_keys.size(); ++i) {
     if (i > 0) {
-      os << ", ";
+      out.Put(", ");
     }
-    os << '"' << type_keys[i] << '\"';
+    out.Put('"');
+    out.Put(type_keys[i]);
+    out.Put('"');
   }
-  os << "]";
+  out.Put(']');
   if (!tensors.empty()) {
-    os << ", \"tensors\": [";
+    out.Put(", \"tensors\": [");
     for (size_t i = 0; i < tensors.size(); ++i) {
       if (i > 0) {
-        os << ", ";
+        out.Put(", ");
+      }
+      if (out.tensor_file != nullptr) {
+        out.PutTensorFileEntry(&tensors[i]->tensor);
+      } else {
+        out.Put('"');
+        out.PutTensorBase64(&tensors[i]->tensor);
+        out.Put('"');
       }
-      Str b64 = tensors[i]->ToBase64();
-      os << '"' << b64->data() << '"';
     }
-    os << "]";
+    out.Put(']');
   }
-  os << "}";
-  return os.str();
+  out.Put('}');
 }
 
-inline Any Deserialize(const char *json_str, int64_t json_str_len) {
-  int32_t json_type_index_tensor = -1;
-  // Step 0. Parse JSON string
-  UDict json_obj = JSONLoads(json_str, json_str_len);
+inline Str Serialize(Any any) {
+  JSONWriter out;
+  Serialize(any, &out);
+  return Str(std::move(out.buf));
+}
+
+inline void SerializeTo(Any any, const ByteSink &sink, const ByteSink *tensor_sink = nullptr) {
+  JSONWriter out;
+  BinaryWriter tensor_file;
+  out.sink = &sink;
+  if (tensor_sink != nullptr) {
+    tensor_file.sink = tensor_sink;
+    out.tensor_file = &tensor_file;
+  }
+  Serialize(any, &out);
+  out.Flush();
+  if (tensor_sink != nullptr) {
+    tensor_file.Flush();
+  }
+}
+
+/*!
+ * \brief Decodes the base64 tensors of a JSON document. Large batches are decoded on the worker pool in the
+ * background, so that the values before the first one that refers to a tensor are constructed in the meantime.
+ */
+struct JSONTensorDecoder {
+  static constexpr int64_t kBackgroundMinBytes = 1 << 16;
+
+  ~JSONTensorDecoder() {
+    // The background task refers to `b64` and `tensors`
+    if (task.valid()) {
+      task.wait();
+    }
+  }
+
+  void Add(std::string_view b64) {
+    this->b64.push_back(b64);
+    this->tensors.emplace_back();
+    this->total_bytes += static_cast<int64_t>(b64.size());
+  }
+
+  void Add(Tensor tensor) {
+    this->b64.emplace_back();
+    this->tensors.push_back(std::move(tensor));
+  }
+
+  void Start() {
+    int64_t num_tensors = this->size();
+    if (this->total_bytes < kBackgroundMinBytes) {
+      for (int64_t i = 0; i < num_tensors; ++i) {
+        this->Decode(i);
+      }
+    } else {
+      this->task = std::async(std::launch::async, [this, num_tensors]() {
+        WorkerPool::Global()->ParallelFor(num_tensors, [this](int64_t i) { this->Decode(i); });
+      });
+    }
+  }
+
+  void Wait() {
+    if (this->task.valid()) {
+      this->task.get();
+    }
+  }
+
+  const Any &Get(int64_t k) {
+    this->Wait();
+    return this->tensors[k];
+  }
+
+  int64_t size() const { return static_cast<int64_t>(b64.size()); }
+
+private:
+  void Decode(int64_t i) {
+    if (this->tensors[i].type_index != kMLCNone) {
+      return;
+    }
+    std::string_view b64 = this->b64[i];
+    Str bytes = Base64Decode(reinterpret_cast<const uint8_t *>(b64.data()), static_cast<int64_t>(b64.size()));
+    this->tensors[i] = TensorFromBytes(reinterpret_cast<const uint8_t *>(bytes->data()), bytes->size());
+  }
+
+  std::vector<std::string_view> b64;
+  std::vector<Any> tensors;
+  std::future<void> task;
+  int64_t total_bytes = 0;
+};
+
+/*!
+ * \brief Constructs objects straight from the JSON text, without building it as a tree of `UDict`/`UList` first.
+ * As `values` precedes `type_keys` in the document, it is skipped over in a first pass and revisited after.
+ * Tensors stored as `[offset, nbytes]` are views into `tensor_file`.
+ */
+inline Any Deserialize(const char *json_str, int64_t json_str_len, MappedFile *tensor_file = nullptr) {
+  if (json_str_len < 0) {
+    json_str_len = static_cast<int64_t>(std::strlen(json_str));
+  }
+  JSONParser parser{0, json_str_len, json_str, {}, {}, 0};
+  parser.Index();
+  // Step 0. Locate `values`, and read `type_keys` and `tensors`
+  int64_t values_begin = -1;
+  std::vector<Str> type_keys;
+  std::deque<std::string> unescaped_b64;
+  JSONTensorDecoder tensors;
+  bool has_type_keys = false;
+  auto parse_array = [&parser](auto on_element) {
+    parser.SkipWhitespace();
+    parser.ExpectChar('[');
+    parser.SkipWhitespace();
+    for (bool first = true; parser.PeekChar() != ']'; first = false) {
+      if (!first) {
+        parser.ExpectChar(',');
+        parser.SkipWhitespace();
+      }
+      on_element();
+      parser.SkipWhitespace();
+    }
+    parser.ExpectChar(']');
+  };
+  auto parse_tensor_file_entry = [&parser, &tensors, tensor_file]() -> Tensor {
+    parser.ExpectChar('[');
+    parser.SkipWhitespace();
+    Any offset = parser.ParseNumber();
+    parser.SkipWhitespace();
+    parser.ExpectChar(',');
+    parser.SkipWhitespace();
+    Any num_bytes = parser.ParseNumber();
+    parser.SkipWhitespace();
+    parser.ExpectChar(']');
+    if (offset.type_index != kMLCInt || num_bytes.type_index != kMLCInt) {
+      MLC_THROW(ValueError) << "Invalid tensor file entry: [" << offset << ", " << num_bytes << "]";
+    }
+    if (tensor_file == nullptr) {
+      MLC_THROW(ValueError) << "Tensor #" << tensors.size() << " is stored in a tensor file, which is not given";
+    }
+    return MappedFileTensor(tensor_file, offset.operator int64_t(), num_bytes.operator int64_t());
+  };
+  parser.SkipWhitespace();
+  parser.ExpectChar('{');
+  parser.SkipWhitespace();
+  for (bool first = true; parser.PeekChar() != '}'; first = false) {
+    if (!first) {
+      parser.ExpectChar(',');
+      parser.SkipWhitespace();
+    }
+    std::string decoded;
+    std::string key(parser.ScanStr(&decoded));
+    parser.SkipWhitespace();
+    parser.ExpectChar(':');
+    parser.SkipWhitespace();
+    if (key == "values") {
+      values_begin = parser.i;
+      parser.SkipValue();
+    } else if (key == "type_keys") {
+      has_type_keys = true;
+      parse_array([&]() { type_keys.push_back(parser.ParseStr().operator Str()); });
+    } else if (key == "tensors") {
+      parse_array([&]() {
+        if (parser.PeekChar() == '[') {
+          tensors.Add(parse_tensor_file_entry());
+          return;
+        }
+        std::string_view b64 = parser.ScanStr(&unescaped_b64.emplace_back());
+        if (b64.data() != unescaped_b64.back().data()) {
+          unescaped_b64.pop_back();
+        }
+        tensors.Add(b64);
+      });
+    } else {
+      parser.SkipValue();
+    }
+    parser.SkipWhitespace();
+  }
+  parser.ExpectChar('}');
+  parser.SkipWhitespace();
+  if (parser.i != json_str_len) {
+    MLC_THROW(ValueError) << "JSON parsing failure at position " << parser.i
+                          << ": Extra data after valid JSON. JSON string: " << json_str;
+  }
+  if (values_begin == -1 || !has_type_keys) {
+    MLC_THROW(ValueError) << "Invalid serialized document: `values` or `type_keys` is missing";
+  }
+  tensors.Start();
   // Step 1. type_key => constructors
-  UList type_keys = json_obj->at("type_keys");
+  int32_t json_type_index_tensor = -1;
   std::vector<FuncObj *> constructors;
   constructors.reserve(type_keys.size());
-  for (Str type_key : type_keys) {
+  for (const Str &type_key : type_keys) {
     int32_t type_index = Lib::GetTypeIndex(type_key->data());
     FuncObj *func = nullptr;
     if (type_index != kMLCTensor) {
@@ -1417,84 +3217,900 @@ inline Any Deserialize(const char *json_str, int64_t json_str_len) {
     }
     constructors.push_back(func);
   }
-  auto invoke_init = [&constructors](UList args) {
-    int32_t json_type_index = args[0];
+  auto parse_type_index = [&parser, &constructors]() -> int32_t {
+    parser.SkipWhitespace();
+    Any json_type_index = parser.ParseNumber();
+    if (json_type_index.type_index != kMLCInt || json_type_index.operator int64_t() < 0 ||
+        json_type_index.operator int64_t() >= static_cast<int64_t>(constructors.size())) {
+      MLC_THROW(ValueError) << "Invalid type index: " << json_type_index;
+    }
+    return json_type_index.operator int32_t();
+  };
+  auto invoke_init = [&constructors](int32_t json_type_index, std::vector<Any> &args) -> Any {
+    if (constructors[json_type_index] == nullptr) {
+      MLC_THROW(ValueError) << "Unexpected tensor type in an object";
+    }
     Any ret;
-    ::mlc::base::FuncCall(constructors.at(json_type_index), static_cast<int32_t>(args.size()) - 1, args->data() + 1,
-                          &ret);
+    ::mlc::base::FuncCall(constructors[json_type_index], static_cast<int32_t>(args.size()), args.data(), &ret);
     return ret;
   };
-  // Step 2. Handle tensors
-  std::vector<Tensor> tensors;
-  if (json_obj->count("tensors")) {
-    UList tensors_b64 = json_obj->at("tensors");
-    while (!tensors_b64->empty()) {
-      Tensor tensor = Tensor::FromBase64(tensors_b64->back());
-      tensors.push_back(tensor);
-      tensors_b64->pop_back();
-    }
-    json_obj->erase("tensors");
-    std::reverse(tensors.begin(), tensors.end());
-  }
-  // Step 3. Translate JSON object to objects
-  UList values = json_obj->at("values");
-  for (int64_t i = 0; i < values->size(); ++i) {
-    Any obj = values[i];
-    if (obj.type_index == kMLCList) {
-      UList list = obj.operator UList();
-      int32_t json_type_index = list[0];
+  // Step 2. Construct the values in order, where a top-level integer, or one among the arguments of an object,
+  // refers to an earlier value, and a nested array is an object constructed in place from literal arguments.
+  std::vector<Any> values;
+  std::vector<Any> args;
+  std::vector<Any> nested_args;
+  auto get_ref = [&values, &type_keys](const Any &ref, int32_t json_type_index) -> Any {
+    int64_t k = ref;
+    int64_t i = static_cast<int64_t>(values.size());
+    if (k < 0 || k >= i) {
+      MLC_THROW(ValueError) << "Invalid reference when parsing type `"
+                            << (json_type_index == -1 ? "" : type_keys[json_type_index]->data()) << "`: referring #"
+                            << k << " at #" << i;
+    }
+    return values[k];
+  };
+  parser.Seek(values_begin);
+  parse_array([&]() {
+    char c = parser.PeekChar();
+    if (c == '[') {
+      parser.ExpectChar('[');
+      int32_t json_type_index = parse_type_index();
       if (json_type_index == json_type_index_tensor) {
-        values[i] = tensors[list[1].operator int32_t()];
-        continue;
+        parser.SkipWhitespace();
+        parser.ExpectChar(',');
+        parser.SkipWhitespace();
+        Any k = parser.ParseNumber();
+        if (k.type_index != kMLCInt || k.operator int64_t() < 0 ||
+            k.operator int64_t() >= tensors.size()) {
+          MLC_THROW(ValueError) << "Invalid tensor index: " << k;
+        }
+        parser.SkipWhitespace();
+        parser.ExpectChar(']');
+        values.push_back(tensors.Get(k.operator int64_t()));
+        return;
       }
-      for (int64_t j = 1; j < list.size(); ++j) {
-        Any arg = list[j];
-        if (arg.type_index == kMLCInt) {
-          int64_t k = arg;
-          if (k < i) {
-            list[j] = values[k];
-          } else {
-            MLC_THROW(ValueError) << "Invalid reference when parsing type `" << type_keys[json_type_index]
-                                  << "`: referring #" << k << " at #" << i << ". v = " << obj;
+      args.clear();
+      for (parser.SkipWhitespace(); parser.PeekChar() != ']'; parser.SkipWhitespace()) {
+        parser.ExpectChar(',');
+        parser.SkipWhitespace();
+        char d = parser.PeekChar();
+        if (d == '[') { // an object with literal arguments, e.g. an integer or a device
+          parser.ExpectChar('[');
+          int32_t nested_type_index = parse_type_index();
+          nested_args.clear();
+          for (parser.SkipWhitespace(); parser.PeekChar() != ']'; parser.SkipWhitespace()) {
+            parser.ExpectChar(',');
+            nested_args.push_back(parser.ParseValue());
           }
-        } else if (arg.type_index == kMLCList) {
-          list[j] = invoke_init(arg.operator UList());
-        } else if (arg.type_index == kMLCStr || arg.type_index == kMLCBool || arg.type_index == kMLCFloat ||
-                   arg.type_index == kMLCNone) {
-          // Do nothing
+          parser.ExpectChar(']');
+          args.push_back(invoke_init(nested_type_index, nested_args));
+        } else if (d == '"' || d == 't' || d == 'f' || d == 'n') {
+          args.push_back(parser.ParseValue());
+        } else if (Any num = parser.ParseNumber(); num.type_index == kMLCInt) {
+          args.push_back(get_ref(num, json_type_index));
         } else {
-          MLC_THROW(ValueError) << "Unexpected value: " << arg;
+          args.push_back(std::move(num));
         }
       }
-      values[i] = invoke_init(list);
-    } else if (obj.type_index == kMLCInt) {
-      int32_t k = obj;
-      values[i] = values[k];
-    } else if (obj.type_index == kMLCStr) {
-      // Do nothing
-      // TODO: how about kMLCBool, kMLCFloat, kMLCNone?
+      parser.ExpectChar(']');
+      values.push_back(invoke_init(json_type_index, args));
+    } else if (c == '"' || c == 't' || c == 'f' || c == 'n') {
+      values.push_back(parser.ParseValue());
+    } else if (Any num = parser.ParseNumber(); num.type_index == kMLCInt) {
+      values.push_back(get_ref(num, -1));
     } else {
-      MLC_THROW(ValueError) << "Unexpected value: " << obj;
+      values.push_back(std::move(num));
     }
+  });
+  // Reports tensors that fail to decode even if no value refers to them
+  tensors.Wait();
+  if (values.empty()) {
+    MLC_THROW(ValueError) << "Invalid serialized document: `values` is empty";
   }
-  return values->back();
+  return values.back();
 }
 
-} // namespace
-} // namespace mlc
+inline Any DeserializeWithTensorFile(const char *json_str, int64_t json_str_len, AnyView tensor_file) {
+  if (tensor_file.type_index == kMLCNone) {
+    return Deserialize(json_str, json_str_len);
+  }
+  // Each tensor keeps its own reference to the mapping, and this one is only held while parsing
+  std::unique_ptr<MappedFile, void (*)(MappedFile *)> file(MappedFile::Open(tensor_file.operator Str()->data()),
+                                                           [](MappedFile *ptr) { ptr->DecRef(); });
+  return Deserialize(json_str, json_str_len, file.get());
+}
 
-namespace mlc {
-namespace registry {
+/****************** Binary Serialize / Deserialize ******************/
 
-bool StructuralEqual(AnyView lhs, AnyView rhs, bool bind_free_vars, bool assert_mode) {
-  try {
-    // TODO: support non objects
-    ::mlc::StructuralEqualImpl(lhs.operator Object *(), rhs.operator Object *(), bind_free_vars);
-    return true;
-  } catch (SEqualError &e) {
-    if (assert_mode) {
-      std::ostringstream os;
-      os << "Structural equality check failed at " << e.path << ": " << e.what();
+/*
+ * A binary document holds the same topologically sorted value table and `type_keys` indirection as the JSON one.
+ * Fixed-width integers and floats are little-endian. Sections are written front to back, and the footer locates
+ * them, so that a writer never seeks back.
+ *
+ *   header:    magic (u64), version (u32), reserved (u32)
+ *   values:    each value as a `BinaryTag` byte + payload; the last one is the root
+ *   type_keys: varint count, then each key as varint length + bytes
+ *   tensors:   varint count, then each tensor as varint length + varint padding + zero padding + the
+ *              `TensorToBytes` layout, padded so that the raw data is aligned to `kMLCBinaryTensorAlign`
+ *              bytes from the start of the document
+ *   footer:    number of values (u64), offset of `type_keys` (u64), offset of `tensors` (u64), magic (u64)
+ */
+static const uint64_t kMLCBinaryMagic = 0x3142434C4D9FA3E5;
+constexpr uint32_t kMLCBinaryVersion = 1;
+constexpr int64_t kMLCBinaryHeaderSize = 8 + 4 + 4;
+constexpr int64_t kMLCBinaryFooterSize = 8 + 8 + 8 + 8;
+
+struct BinaryTag {
+  static constexpr uint8_t kNone = 0;
+  static constexpr uint8_t kFalse = 1;
+  static constexpr uint8_t kTrue = 2;
+  static constexpr uint8_t kInt = 3;     // zigzag varint
+  static constexpr uint8_t kFloat = 4;   // f64
+  static constexpr uint8_t kRef = 5;     // varint index of an earlier value
+  static constexpr uint8_t kStr = 6;     // varint length + bytes
+  static constexpr uint8_t kDevice = 7;  // varint device type + varint device id
+  static constexpr uint8_t kDType = 8;   // varint code + varint bits + varint lanes
+  static constexpr uint8_t kObject = 9;  // varint type key index + varint number of fields + fields
+  static constexpr uint8_t kTensor = 10; // varint index into the tensor section
+};
+
+/*!
+ * \brief Reads a document either held in memory, or from a file through a window that is refilled on demand.
+ * Positions are relative to the start of the document, and reads are bounded by `end`, see `Seek`.
+ */
+struct BinaryReader {
+  static BinaryReader FromMemory(const uint8_t *data, int64_t size) {
+    return BinaryReader{data, size, 0, 0, size, size, nullptr, 0, {}};
+  }
+  static BinaryReader FromFile(const FileDescriptorSource *file, int64_t begin) {
+    int64_t doc_size = std::max<int64_t>(0, file->Size() - begin);
+    return BinaryReader{nullptr, 0, 0, 0, doc_size, doc_size, file, begin, {}};
+  }
+  /*! \brief Moves to `pos` and restricts the reads that follow to the range `[pos, end)`. */
+  void Seek(int64_t pos, int64_t end) {
+    if (file == nullptr) {
+      this->head = pos;
+      this->size = end;
+    } else {
+      this->base = pos;
+      this->head = this->size = 0;
+      this->window.clear();
+    }
+    this->end = end;
+  }
+  int64_t Tell() const { return base + head; }
+  void Need(int64_t n) {
+    if (n > size - head) {
+      Refill(n);
+    }
+  }
+  void Refill(int64_t n) {
+    if (file == nullptr || n > end - Tell()) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Unexpected EOF at byte " << Tell();
+    }
+    window.erase(window.begin(), window.begin() + head);
+    base += head;
+    size -= head;
+    head = 0;
+    int64_t want = std::min(std::max(n, kStreamChunkSize), end - base);
+    window.resize(static_cast<size_t>(want));
+    file->ReadAt(begin + base + size, window.data() + size, want - size);
+    size = want;
+    data = window.data();
+  }
+  /*! \brief Copies `n` raw bytes to `dst`; from a file, the bytes past the window are read in place. */
+  void GetRaw(uint8_t *dst, int64_t n) {
+    int64_t avail = std::min(n, size - head);
+    if (avail > 0) {
+      std::memcpy(dst, data + head, static_cast<size_t>(avail));
+      head += avail;
+    }
+    if (avail < n) {
+      if (file == nullptr || n - avail > end - Tell()) {
+        MLC_THROW(ValueError) << "BinaryDeserialize: Unexpected EOF at byte " << Tell();
+      }
+      file->ReadAt(begin + Tell(), dst + avail, n - avail);
+      Seek(Tell() + n - avail, end);
+    }
+  }
+  void Skip(int64_t n) {
+    if (n > end - Tell()) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Unexpected EOF at byte " << Tell();
+    } else if (n <= size - head) {
+      head += n;
+    } else {
+      Seek(Tell() + n, end);
+    }
+  }
+  uint8_t GetByte() {
+    Need(1);
+    return data[head++];
+  }
+  uint64_t GetVarint() {
+    uint64_t v = 0;
+    for (int32_t shift = 0; shift < 64; shift += 7) {
+      uint8_t b = GetByte();
+      v |= static_cast<uint64_t>(b & 0x7F) << shift;
+      if ((b & 0x80) == 0) {
+        return v;
+      }
+    }
+    MLC_THROW(ValueError) << "BinaryDeserialize: Malformed varint at byte " << Tell();
+    MLC_UNREACHABLE();
+  }
+  int64_t GetSize() {
+    uint64_t v = GetVarint();
+    if (v > static_cast<uint64_t>(doc_size)) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Size out of range at byte " << Tell() << ": " << v;
+    }
+    return static_cast<int64_t>(v);
+  }
+  template <int N, typename T> T GetFixed() {
+    Need(N);
+    return ReadElem<N, T>(data, &head, size);
+  }
+  Str GetStr() {
+    int64_t length = GetSize();
+    Need(length);
+    Str ret(::mlc::core::StrPad::Allocator::NewWithPad<uint8_t>(length + 1, length));
+    std::memcpy(ret->data(), data + head, static_cast<size_t>(length));
+    ret->data()[length] = '\0';
+    head += length;
+    return ret;
+  }
+  /*! \brief Reads the `TensorToBytes` layout of `num_bytes` bytes, copying the raw data straight into the tensor. */
+  Tensor GetTensor(int64_t num_bytes) {
+    if (num_bytes < TensorBytesHeaderSize(0) || num_bytes > end - Tell()) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Corrupted tensor at byte " << Tell();
+    }
+    Need(TensorBytesHeaderSize(0));
+    int64_t ndim_pos = head + 8;
+    int32_t ndim = ReadElem<4, int32_t>(data, &ndim_pos, size);
+    if (ndim < 0 || TensorBytesHeaderSize(ndim) > num_bytes) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Corrupted tensor at byte " << Tell();
+    }
+    Need(TensorBytesHeaderSize(ndim));
+    int64_t header_end = head + TensorBytesHeaderSize(ndim);
+    Tensor ret = TensorNewFromBytesHeader(data, &head, header_end, head + num_bytes);
+    DLTensor *tensor = &ret->tensor;
+    int32_t elem_size = ::mlc::base::DataTypeSize(tensor->dtype);
+    int64_t numel = ::mlc::core::ShapeToNumel(tensor->ndim, tensor->shape);
+    if (TensorBytesHeaderSize(ndim) + numel * elem_size != num_bytes) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Corrupted tensor at byte " << Tell();
+    }
+    uint8_t *content = static_cast<uint8_t *>(tensor->data);
+    GetRaw(content, numel * elem_size);
+    SwapElemBytes(content, elem_size, numel);
+    return ret;
+  }
+  const uint8_t *data; // window, or the whole document when reading from memory
+  int64_t size;        // number of valid bytes in `data`
+  int64_t head;        // cursor in `data`
+  int64_t base;        // document position of `data[0]`
+  int64_t end;         // document position reads are bounded by
+  int64_t doc_size;
+  const FileDescriptorSource *file;
+  int64_t begin; // file offset of the document
+  std::vector<uint8_t> window;
+};
+
+inline void BinarySerialize(Any any, BinaryWriter *writer) {
+  std::vector<const char *> type_keys;
+  std::unordered_map<const char *, int32_t> type_key2index;
+  std::unordered_map<Object *, int32_t> topo_indices;
+  std::vector<TensorObj *> tensors;
+  BinaryWriter &out = *writer;
+  out.PutFixed<8>(kMLCBinaryMagic);
+  out.PutFixed<4>(kMLCBinaryVersion);
+  out.PutFixed<4>(static_cast<uint32_t>(0));
+  auto get_type_index = [&type_key2index, &type_keys](const char *type_key) -> int32_t {
+    auto [it, inserted] = type_key2index.try_emplace(type_key, static_cast<int32_t>(type_keys.size()));
+    if (inserted) {
+      type_keys.push_back(type_key);
+    }
+    return it->second;
+  };
+  struct Emitter {
+    MLC_INLINE void operator()(MLCTypeField *, const Any *any) { EmitAny(any); }
+    // clang-format off
+    MLC_INLINE void operator()(MLCTypeField *, ObjectRef *obj) { if (Object *v = obj->get()) EmitObject(v); else EmitNil(); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<ObjectRef> *opt) { if (Object *v = opt->get()) EmitObject(v); else EmitNil(); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<bool> *opt) { if (const bool *v = opt->get()) EmitBool(*v); else EmitNil(); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<int64_t> *opt) { if (const int64_t *v = opt->get()) EmitInt(*v); else EmitNil(); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<double> *opt) { if (const double *v = opt->get())  EmitFloat(*v); else EmitNil(); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<DLDevice> *opt) { if (const DLDevice *v = opt->get()) EmitDevice(*v); else EmitNil(); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<DLDataType> *opt) { if (const DLDataType *v = opt->get()) EmitDType(*v); else EmitNil(); }
+    // clang-format on
+    MLC_INLINE void operator()(MLCTypeField *, bool *v) { EmitBool(*v); }
+    MLC_INLINE void operator()(MLCTypeField *, int8_t *v) { EmitInt(static_cast<int64_t>(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, int16_t *v) { EmitInt(static_cast<int64_t>(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, int32_t *v) { EmitInt(static_cast<int64_t>(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, int64_t *v) { EmitInt(static_cast<int64_t>(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, float *v) { EmitFloat(static_cast<double>(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, double *v) { EmitFloat(static_cast<double>(*v)); }
+    MLC_INLINE void operator()(MLCTypeField *, DLDataType *v) { EmitDType(*v); }
+    MLC_INLINE void operator()(MLCTypeField *, DLDevice *v) { EmitDevice(*v); }
+    MLC_INLINE void operator()(MLCTypeField *, Optional<void *> *) {
+      MLC_THROW(TypeError) << "Unserializable type: void *";
+    }
+    MLC_INLINE void operator()(MLCTypeField *, void **) { MLC_THROW(TypeError) << "Unserializable type: void *"; }
+    MLC_INLINE void operator()(MLCTypeField *, const char **) {
+      MLC_THROW(TypeError) << "Unserializable type: const char *";
+    }
+    inline void EmitNil() { out->PutByte(BinaryTag::kNone); }
+    inline void EmitBool(bool v) { out->PutByte(v ? BinaryTag::kTrue : BinaryTag::kFalse); }
+    inline void EmitInt(int64_t v) {
+      out->PutByte(BinaryTag::kInt);
+      out->PutVarint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+    }
+    inline void EmitFloat(double v) {
+      out->PutByte(BinaryTag::kFloat);
+      out->PutFixed<8>(v);
+    }
+    inline void EmitDevice(DLDevice v) {
+      out->PutByte(BinaryTag::kDevice);
+      out->PutVarint(static_cast<uint64_t>(v.device_type));
+      out->PutVarint(static_cast<uint64_t>(static_cast<uint32_t>(v.device_id)));
+    }
+    inline void EmitDType(DLDataType v) {
+      out->PutByte(BinaryTag::kDType);
+      out->PutVarint(v.code);
+      out->PutVarint(v.bits);
+      out->PutVarint(v.lanes);
+    }
+    inline void EmitStr(const char *data, int64_t length) {
+      out->PutByte(BinaryTag::kStr);
+      out->PutBytes(data, length);
+    }
+    inline void EmitAny(const Any *any) {
+      int32_t type_index = any->type_index;
+      if (type_index == kMLCNone) {
+        EmitNil();
+      } else if (type_index == kMLCBool) {
+        EmitBool(any->operator bool());
+      } else if (type_index == kMLCInt) {
+        EmitInt(any->operator int64_t());
+      } else if (type_index == kMLCFloat) {
+        EmitFloat(any->operator double());
+      } else if (type_index == kMLCDevice) {
+        EmitDevice(any->operator DLDevice());
+      } else if (type_index == kMLCDataType) {
+        EmitDType(any->operator DLDataType());
+      } else if (type_index == kMLCSmallStr) {
+        EmitStr(any->v.v_bytes, any->small_len);
+      } else if (type_index >= kMLCStaticObjectBegin) {
+        EmitObject(any->operator Object *());
+      } else {
+        MLC_THROW(TypeError) << "Cannot serialize type: " << Lib::GetTypeKey(type_index);
+      }
+    }
+    inline void EmitObject(Object *obj) {
+      out->PutByte(BinaryTag::kRef);
+      out->PutVarint(static_cast<uint64_t>(obj2index->at(obj)));
+    }
+    BinaryWriter *out;
+    const std::unordered_map<Object *, int32_t> *obj2index;
+  };
+  Emitter emitter{&out, &topo_indices};
+  auto on_visit = [&](Object *object, MLCTypeInfo *type_info) -> void {
+    out.MaybeFlush();
+    int32_t topo_index = static_cast<int32_t>(topo_indices.size());
+    if (!topo_indices.emplace(object, topo_index).second) {
+      MLC_THROW(InternalError) << "This should never happen: object already visited";
+    }
+    if (StrObj *str = object->TryCast<StrObj>()) {
+      emitter.EmitStr(str->data(), str->size());
+      return;
+    }
+    if (TensorObj *tensor = object->TryCast<TensorObj>()) {
+      out.PutByte(BinaryTag::kTensor);
+      out.PutVarint(tensors.size());
+      tensors.push_back(tensor);
+      return;
+    }
+    out.PutByte(BinaryTag::kObject);
+    out.PutVarint(static_cast<uint64_t>(get_type_index(type_info->type_key)));
+    if (UListObj *list = object->TryCast<UListObj>()) {
+      out.PutVarint(static_cast<uint64_t>(list->size()));
+      for (Any &any : *list) {
+        emitter(nullptr, &any);
+        out.MaybeFlush();
+      }
+    } else if (UDictObj *dict = object->TryCast<UDictObj>()) {
+      out.PutVarint(static_cast<uint64_t>(dict->size()) * 2);
+      for (auto &kv : *dict) {
+        emitter(nullptr, &kv.first);
+        emitter(nullptr, &kv.second);
+        out.MaybeFlush();
+      }
+    } else if (object->IsInstance<FuncObj>() || object->IsInstance<ErrorObj>()) {
+      MLC_THROW(TypeError) << "Unserializable type: " << object->GetTypeKey();
+    } else if (object->IsInstance<OpaqueObj>()) {
+      MLC_THROW(TypeError) << "Cannot serialize `mlc.Opaque` of type: " << object->Cast<OpaqueObj>()->opaque_type_name;
+    } else {
+      uint64_t num_fields = 0;
+      VisitFields(object, type_info, [&num_fields](MLCTypeField *, auto *) { ++num_fields; });
+      out.PutVarint(num_fields);
+      VisitFields(object, type_info, emitter);
+    }
+  };
+  if (any.type_index >= kMLCStaticObjectBegin) {
+    TopoVisit(any.operator Object *(), nullptr, on_visit);
+  } else {
+    emitter.EmitAny(&any);
+  }
+  int64_t type_keys_offset = out.Tell();
+  out.PutVarint(type_keys.size());
+  for (const char *type_key : type_keys) {
+    out.PutBytes(type_key, static_cast<int64_t>(std::strlen(type_key)));
+  }
+  int64_t tensors_offset = out.Tell();
+  out.PutVarint(tensors.size());
+  for (TensorObj *tensor : tensors) {
+    int64_t num_bytes = TensorBytesSize(&tensor->tensor);
+    out.PutVarint(static_cast<uint64_t>(num_bytes));
+    // Padding is less than `kMLCBinaryTensorAlign`, so its varint takes one byte
+    int64_t data_begin = out.Tell() + 1 + TensorBytesHeaderSize(tensor->tensor.ndim);
+    int64_t padding = (kMLCBinaryTensorAlign - data_begin % kMLCBinaryTensorAlign) % kMLCBinaryTensorAlign;
+    out.PutVarint(static_cast<uint64_t>(padding));
+    out.Reserve(padding);
+    out.PutTensorBytes(&tensor->tensor);
+  }
+  out.PutFixed<8>(static_cast<uint64_t>(topo_indices.empty() ? 1 : topo_indices.size()));
+  out.PutFixed<8>(static_cast<uint64_t>(type_keys_offset));
+  out.PutFixed<8>(static_cast<uint64_t>(tensors_offset));
+  out.PutFixed<8>(kMLCBinaryMagic);
+}
+
+inline Str BinarySerialize(Any any) {
+  BinaryWriter out;
+  BinarySerialize(any, &out);
+  return Str(std::move(out.buf));
+}
+
+inline void BinarySerializeTo(Any any, const ByteSink &sink) {
+  BinaryWriter out;
+  out.sink = &sink;
+  BinarySerialize(any, &out);
+  out.Flush();
+}
+
+/*! \brief Positions of the sections of a binary document, read from and validated against its header and footer. */
+struct BinaryLayout {
+  static BinaryLayout Read(BinaryReader &reader) {
+    int64_t size = reader.doc_size;
+    reader.Seek(0, size);
+    if (size < kMLCBinaryHeaderSize + kMLCBinaryFooterSize || reader.GetFixed<8, uint64_t>() != kMLCBinaryMagic) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Magic number mismatch.";
+    }
+    if (uint32_t version = reader.GetFixed<4, uint32_t>(); version != kMLCBinaryVersion) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Unsupported version " << version << ", expected "
+                            << kMLCBinaryVersion;
+    }
+    reader.Seek(size - kMLCBinaryFooterSize, size);
+    uint64_t num_values = reader.GetFixed<8, uint64_t>();
+    uint64_t type_keys_offset = reader.GetFixed<8, uint64_t>();
+    uint64_t tensors_offset = reader.GetFixed<8, uint64_t>();
+    if (reader.GetFixed<8, uint64_t>() != kMLCBinaryMagic) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Unexpected EOF, footer not found.";
+    }
+    int64_t footer_offset = size - kMLCBinaryFooterSize;
+    if (num_values > static_cast<uint64_t>(size) || type_keys_offset < static_cast<uint64_t>(kMLCBinaryHeaderSize) ||
+        type_keys_offset > tensors_offset || tensors_offset > static_cast<uint64_t>(footer_offset)) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Corrupted footer.";
+    }
+    return BinaryLayout{static_cast<int64_t>(num_values), static_cast<int64_t>(type_keys_offset),
+                        static_cast<int64_t>(tensors_offset), footer_offset};
+  }
+
+  /*! \brief Reads the type key table, returning the type index of each entry. */
+  std::vector<int32_t> ReadTypeIndices(BinaryReader &reader) const {
+    reader.Seek(type_keys_offset, tensors_offset);
+    std::vector<int32_t> type_indices(static_cast<size_t>(reader.GetSize()));
+    for (int32_t &type_index : type_indices) {
+      Str type_key = reader.GetStr();
+      type_index = Lib::GetTypeIndex(type_key->data());
+    }
+    return type_indices;
+  }
+
+  int64_t num_values;
+  int64_t type_keys_offset;
+  int64_t tensors_offset;
+  int64_t footer_offset;
+};
+
+/*!
+ * \brief Reads a value other than an object record, given its tag. References and tensors are resolved by
+ * `get_ref(k)` and `get_tensor(k)`, which validate `k`; tensors only appear at the top level of the value table.
+ */
+template <typename FRef, typename FTensor>
+Any BinaryReadValue(BinaryReader &reader, uint8_t tag, bool top_level, FRef get_ref, FTensor get_tensor) {
+  switch (tag) {
+  case BinaryTag::kNone:
+    return Any();
+  case BinaryTag::kFalse:
+    return Any(false);
+  case BinaryTag::kTrue:
+    return Any(true);
+  case BinaryTag::kInt: {
+    uint64_t v = reader.GetVarint();
+    return Any(static_cast<int64_t>((v >> 1) ^ (~(v & 1) + 1)));
+  }
+  case BinaryTag::kFloat:
+    return Any(reader.GetFixed<8, double>());
+  case BinaryTag::kRef:
+    return get_ref(reader.GetVarint());
+  case BinaryTag::kStr:
+    return Any(reader.GetStr());
+  case BinaryTag::kDevice: {
+    int32_t device_type = static_cast<int32_t>(reader.GetVarint());
+    int32_t device_id = static_cast<int32_t>(static_cast<uint32_t>(reader.GetVarint()));
+    return Any(DLDevice{static_cast<DLDeviceType>(device_type), device_id});
+  }
+  case BinaryTag::kDType: {
+    uint8_t code = static_cast<uint8_t>(reader.GetVarint());
+    uint8_t bits = static_cast<uint8_t>(reader.GetVarint());
+    uint16_t lanes = static_cast<uint16_t>(reader.GetVarint());
+    return Any(DLDataType{code, bits, lanes});
+  }
+  case BinaryTag::kTensor:
+    if (top_level) {
+      return get_tensor(reader.GetVarint());
+    }
+    break;
+  default:
+    break;
+  }
+  MLC_THROW(ValueError) << "BinaryDeserialize: Unexpected tag " << static_cast<int32_t>(tag) << " at byte "
+                        << reader.Tell() - 1;
+  MLC_UNREACHABLE();
+}
+
+/*! \brief Skips what `BinaryReadValue` would read, returning the index a `kRef` refers to, or -1. */
+inline int64_t BinarySkipValue(BinaryReader &reader, uint8_t tag) {
+  switch (tag) {
+  case BinaryTag::kNone:
+  case BinaryTag::kFalse:
+  case BinaryTag::kTrue:
+    return -1;
+  case BinaryTag::kInt:
+  case BinaryTag::kTensor:
+    reader.GetVarint();
+    return -1;
+  case BinaryTag::kFloat:
+    reader.Skip(8);
+    return -1;
+  case BinaryTag::kRef:
+    return static_cast<int64_t>(std::min<uint64_t>(reader.GetVarint(), INT64_MAX));
+  case BinaryTag::kStr:
+    reader.Skip(reader.GetSize());
+    return -1;
+  case BinaryTag::kDevice:
+    reader.GetVarint();
+    reader.GetVarint();
+    return -1;
+  case BinaryTag::kDType:
+    reader.GetVarint();
+    reader.GetVarint();
+    reader.GetVarint();
+    return -1;
+  default:
+    break;
+  }
+  MLC_THROW(ValueError) << "BinaryDeserialize: Unexpected tag " << static_cast<int32_t>(tag) << " at byte "
+                        << reader.Tell() - 1;
+  MLC_UNREACHABLE();
+}
+
+inline Any BinaryDeserialize(BinaryReader &reader) {
+  BinaryLayout layout = BinaryLayout::Read(reader);
+  // Step 1. type_key => constructors
+  std::vector<FuncObj *> constructors;
+  for (int32_t type_index : layout.ReadTypeIndices(reader)) {
+    constructors.push_back(Lib::_init(type_index));
+  }
+  // Step 2. Tensors
+  reader.Seek(layout.tensors_offset, layout.footer_offset);
+  std::vector<Tensor> tensors(static_cast<size_t>(reader.GetSize()), Tensor(Null));
+  for (Tensor &tensor : tensors) {
+    int64_t num_bytes = reader.GetSize();
+    reader.Skip(reader.GetSize());
+    tensor = reader.GetTensor(num_bytes);
+  }
+  // Step 3. Values
+  reader.Seek(kMLCBinaryHeaderSize, layout.type_keys_offset);
+  std::vector<Any> values;
+  values.reserve(static_cast<size_t>(layout.num_values));
+  std::vector<Any> args;
+  int64_t i = 0;
+  auto get_ref = [&values, &i](uint64_t k) -> Any {
+    if (k >= static_cast<uint64_t>(i)) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Invalid reference: referring #" << k << " at #" << i;
+    }
+    return values[k];
+  };
+  auto get_tensor = [&tensors, &i](uint64_t k) -> Any {
+    if (k >= tensors.size()) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Invalid tensor index #" << k << " at #" << i;
+    }
+    return tensors[k];
+  };
+  for (; i < layout.num_values; ++i) {
+    if (uint8_t tag = reader.GetByte(); tag != BinaryTag::kObject) {
+      values.push_back(BinaryReadValue(reader, tag, true, get_ref, get_tensor));
+      continue;
+    }
+    uint64_t json_type_index = reader.GetVarint();
+    if (json_type_index >= constructors.size()) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Invalid type index #" << json_type_index << " at #" << i;
+    }
+    int64_t num_args = reader.GetSize();
+    args.clear();
+    for (int64_t j = 0; j < num_args; ++j) {
+      args.push_back(BinaryReadValue(reader, reader.GetByte(), false, get_ref, get_tensor));
+    }
+    Any ret;
+    ::mlc::base::FuncCall(constructors[json_type_index], static_cast<int32_t>(num_args), args.data(), &ret);
+    values.push_back(std::move(ret));
+  }
+  if (values.empty()) {
+    MLC_THROW(ValueError) << "BinaryDeserialize: Empty value table";
+  }
+  return values.back();
+}
+
+inline Any BinaryDeserialize(const uint8_t *data, int64_t size) {
+  BinaryReader reader = BinaryReader::FromMemory(data, size);
+  return BinaryDeserialize(reader);
+}
+
+/*! \brief Loads the binary document that spans from `offset` to the end of the file, a window at a time. */
+inline Any BinaryDeserializeFrom(int64_t fd, int64_t offset) {
+  FileDescriptorSource file{fd};
+  BinaryReader reader = BinaryReader::FromFile(&file, offset);
+  return BinaryDeserialize(reader);
+}
+
+/****************** Mapped Binary ******************/
+
+/*!
+ * \brief A binary document, see `BinarySerialize`, that is memory-mapped and indexed instead of loaded. A value is
+ * only constructed when it is requested, together with the values it refers to; tensors view the mapping in place.
+ */
+struct MappedBinary {
+  explicit MappedBinary(const char *path) : file(MappedFile::Open(path)) {
+    try {
+      reader = BinaryReader::FromMemory(file->data, file->size);
+      BinaryLayout layout = BinaryLayout::Read(reader);
+      type_indices = layout.ReadTypeIndices(reader);
+      constructors.resize(type_indices.size(), nullptr);
+      // Index the tensors, whose data is left untouched until they are requested
+      reader.Seek(layout.tensors_offset, layout.footer_offset);
+      int64_t num_tensors = reader.GetSize();
+      for (int64_t i = 0; i < num_tensors; ++i) {
+        int64_t num_bytes = reader.GetSize();
+        reader.Skip(reader.GetSize());
+        tensor_offsets.push_back(reader.Tell());
+        tensor_sizes.push_back(num_bytes);
+        reader.Skip(num_bytes);
+      }
+      // Index the values, each spanning from its offset to the next one
+      reader.Seek(kMLCBinaryHeaderSize, layout.type_keys_offset);
+      for (int64_t i = 0; i < layout.num_values; ++i) {
+        value_offsets.push_back(reader.Tell());
+        if (uint8_t tag = reader.GetByte(); tag == BinaryTag::kObject) {
+          reader.GetVarint();
+          for (int64_t j = 0, num_args = reader.GetSize(); j < num_args; ++j) {
+            BinarySkipValue(reader, reader.GetByte());
+          }
+        } else {
+          BinarySkipValue(reader, tag);
+        }
+      }
+      if (value_offsets.empty()) {
+        MLC_THROW(ValueError) << "BinaryDeserialize: Empty value table";
+      }
+      value_offsets.push_back(reader.Tell());
+      values.resize(static_cast<size_t>(layout.num_values));
+      states.resize(static_cast<size_t>(layout.num_values), kUnvisited);
+    } catch (...) {
+      file->DecRef();
+      throw;
+    }
+  }
+
+  MappedBinary(const MappedBinary &) = delete;
+  MappedBinary &operator=(const MappedBinary &) = delete;
+  ~MappedBinary() {
+    values.clear();
+    file->DecRef();
+  }
+
+  int64_t NumValues() const { return static_cast<int64_t>(values.size()); }
+
+  /*! \brief Constructs value #i, after the values it refers to that are not constructed yet. */
+  Any Get(int64_t i) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return GetLocked(i);
+  }
+
+  /*!
+   * \brief Describes value #i without constructing it, as `[type_key, args, refs]`. For an object record, `args`
+   * holds its constructor arguments, with None in place of references, and `refs[j]` is the index of the value
+   * argument `j` refers to, or -1. Other values are constructed, and described as `[None, [value], [-1]]`.
+   */
+  UList Entry(int64_t i) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return EntryLocked(i);
+  }
+
+private:
+  Any GetLocked(int64_t i) {
+    CheckIndex(i);
+    if (states[i] == kConstructed) {
+      return values[i];
+    }
+    // References only point backwards, so constructing the closure in ascending order resolves all of them
+    std::vector<int64_t> pending{i}, closure;
+    states[i] = kQueued;
+    while (!pending.empty()) {
+      int64_t k = pending.back();
+      pending.pop_back();
+      closure.push_back(k);
+      ForEachRef(k, [this, &pending](int64_t, int64_t ref) {
+        if (states[ref] == kUnvisited) {
+          states[ref] = kQueued;
+          pending.push_back(ref);
+        }
+      });
+    }
+    std::sort(closure.begin(), closure.end());
+    try {
+      for (int64_t k : closure) {
+        values[k] = Construct(k);
+        states[k] = kConstructed;
+      }
+    } catch (...) {
+      for (int64_t k : closure) {
+        if (states[k] == kQueued) {
+          states[k] = kUnvisited;
+        }
+      }
+      throw;
+    }
+    return values[i];
+  }
+
+  UList EntryLocked(int64_t i) {
+    CheckIndex(i);
+    reader.Seek(value_offsets[i], value_offsets[i + 1]);
+    if (reader.GetByte() != BinaryTag::kObject) {
+      return UList{Any(), UList{GetLocked(i)}, UList{-1}};
+    }
+    int32_t type_index = type_indices.at(CheckTypeIndex(reader.GetVarint(), i));
+    UList args, refs;
+    auto no_ref = [](uint64_t) -> Any { return Any(); }; // references are handled below
+    for (int64_t j = 0, num_args = reader.GetSize(); j < num_args; ++j) {
+      uint8_t tag = reader.GetByte();
+      if (tag == BinaryTag::kRef) {
+        refs.push_back(CheckRef(reader.GetVarint(), i));
+        args.push_back(Any());
+      } else {
+        refs.push_back(-1);
+        args.push_back(BinaryReadValue(reader, tag, false, no_ref, no_ref));
+      }
+    }
+    return UList{Any(Lib::GetTypeKey(type_index)), args, refs};
+  }
+
+  static constexpr uint8_t kUnvisited = 0;
+  static constexpr uint8_t kQueued = 1;
+  static constexpr uint8_t kConstructed = 2;
+
+  void CheckIndex(int64_t i) const {
+    if (i < 0 || i >= NumValues()) {
+      MLC_THROW(IndexError) << "Value index out of range: " << i << ", number of values: " << NumValues();
+    }
+  }
+
+  int64_t CheckRef(uint64_t ref, int64_t i) const {
+    if (ref >= static_cast<uint64_t>(i)) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Invalid reference: referring #" << ref << " at #" << i;
+    }
+    return static_cast<int64_t>(ref);
+  }
+
+  size_t CheckTypeIndex(uint64_t json_type_index, int64_t i) const {
+    if (json_type_index >= type_indices.size()) {
+      MLC_THROW(ValueError) << "BinaryDeserialize: Invalid type index #" << json_type_index << " at #" << i;
+    }
+    return static_cast<size_t>(json_type_index);
+  }
+
+  template <typename F> void ForEachRef(int64_t i, F f) {
+    reader.Seek(value_offsets[i], value_offsets[i + 1]);
+    int64_t num_args = 1;
+    if (uint8_t tag = reader.GetByte(); tag == BinaryTag::kObject) {
+      reader.GetVarint();
+      num_args = reader.GetSize();
+    } else {
+      reader.Seek(value_offsets[i], value_offsets[i + 1]);
+    }
+    for (int64_t j = 0; j < num_args; ++j) {
+      if (int64_t ref = BinarySkipValue(reader, reader.GetByte()); ref != -1) {
+        f(j, CheckRef(static_cast<uint64_t>(ref), i));
+      }
+    }
+  }
+
+  Any Construct(int64_t i) {
+    auto get_ref = [this](uint64_t k) -> Any { return values[k]; };
+    auto get_tensor = [this, i](uint64_t k) -> Any {
+      if (k >= tensor_offsets.size()) {
+        MLC_THROW(ValueError) << "BinaryDeserialize: Invalid tensor index #" << k << " at #" << i;
+      }
+      return TensorView(static_cast<size_t>(k));
+    };
+    reader.Seek(value_offsets[i], value_offsets[i + 1]);
+    if (uint8_t tag = reader.GetByte(); tag != BinaryTag::kObject) {
+      return BinaryReadValue(reader, tag, true, get_ref, get_tensor);
+    }
+    size_t json_type_index = CheckTypeIndex(reader.GetVarint(), i);
+    if (constructors[json_type_index] == nullptr) {
+      constructors[json_type_index] = Lib::_init(type_indices[json_type_index]);
+    }
+    int64_t num_args = reader.GetSize();
+    std::vector<Any> args;
+    args.reserve(static_cast<size_t>(num_args));
+    for (int64_t j = 0; j < num_args; ++j) {
+      args.push_back(BinaryReadValue(reader, reader.GetByte(), false, get_ref, get_tensor));
+    }
+    Any ret;
+    ::mlc::base::FuncCall(constructors[json_type_index], static_cast<int32_t>(num_args), args.data(), &ret);
+    return ret;
+  }
+
+  Tensor TensorView(size_t k) { return MappedFileTensor(file, tensor_offsets[k], tensor_sizes[k]); }
+
+  MappedFile *file;
+  BinaryReader reader = BinaryReader::FromMemory(nullptr, 0);
+  std::vector<int32_t> type_indices;
+  std::vector<FuncObj *> constructors;
+  std::vector<int64_t> tensor_offsets;
+  std::vector<int64_t> tensor_sizes;
+  std::vector<int64_t> value_offsets;
+  std::vector<Any> values;
+  std::vector<uint8_t> states;
+  // Taken by `Get` and `Entry`, which share `reader` and the constructed values across threads
+  std::mutex mutex;
+};
+
+inline Object *AsObject(AnyView source, Str *storage) {
+  // Small strings are boxed so that they behave the same as heap-allocated `Str` at the root
+  if (source.type_index == kMLCSmallStr) {
+    *storage = source.operator Str();
+    return reinterpret_cast<Object *>(storage->get());
+  }
+  return source.operator Object *();
+}
+
+} // namespace
+} // namespace mlc
+
+namespace mlc {
+namespace registry {
+
+bool StructuralEqual(AnyView lhs, AnyView rhs, bool bind_free_vars, bool assert_mode) {
+  try {
+    // TODO: support non objects
+    Str lhs_storage{Null}, rhs_storage{Null};
+    ::mlc::StructuralEqualImpl(AsObject(lhs, &lhs_storage), AsObject(rhs, &rhs_storage), bind_free_vars);
+    return true;
+  } catch (SEqualError &e) {
+    if (assert_mode) {
+      std::ostringstream os;
+      os << "Structural equality check failed at " << e.path << ": " << e.what();
       MLC_THROW(ValueError) << os.str();
     }
   }
@@ -1503,11 +4119,105 @@ bool StructuralEqual(AnyView lhs, AnyView rhs, bool bind_free_vars, bool assert_
 
 int64_t StructuralHash(AnyView root) {
   // TODO: support non objects
-  return static_cast<int64_t>(::mlc::StructuralHashImpl(root.operator Object *()));
+  Str storage{Null};
+  return static_cast<int64_t>(::mlc::StructuralHashImpl<::mlc::Hash64>(AsObject(root, &storage)));
+}
+
+List<int64_t> StructuralHash128(AnyView root) {
+  Str storage{Null};
+  ::mlc::Hash128::Value hash = ::mlc::StructuralHashImpl<::mlc::Hash128>(AsObject(root, &storage));
+  return List<int64_t>{static_cast<int64_t>(hash.lo), static_cast<int64_t>(hash.hi)};
+}
+
+List<int64_t> StructuralHashMany(UList roots) {
+  int64_t num_roots = roots->size();
+  std::vector<Str> storage(num_roots, Str(Null));
+  std::vector<Object *> objs(num_roots);
+  for (int64_t i = 0; i < num_roots; ++i) {
+    objs[i] = AsObject(roots->at(i), &storage[i]);
+  }
+  std::vector<int64_t> hashes(num_roots);
+  ::mlc::WorkerPool::Global()->ParallelFor(num_roots, [&objs, &hashes](int64_t i) {
+    thread_local ::mlc::StructuralHashScratch<::mlc::Hash64> scratch;
+    hashes[i] = static_cast<int64_t>(::mlc::StructuralHashImpl<::mlc::Hash64>(objs[i], nullptr, &scratch));
+  });
+  return List<int64_t>(hashes.begin(), hashes.end());
+}
+
+List<bool> StructuralEqualMany(UList pairs, bool bind_free_vars) {
+  int64_t num_pairs = pairs->size();
+  std::vector<Str> storage(num_pairs * 2, Str(Null));
+  std::vector<Object *> objs(num_pairs * 2);
+  for (int64_t i = 0; i < num_pairs; ++i) {
+    UListObj *pair = pairs->at(i).TryCast<UListObj>();
+    if (pair == nullptr || pair->size() != 2) {
+      MLC_THROW(ValueError) << "Expected a pair of objects to compare, but got: " << pairs->at(i);
+    }
+    objs[2 * i] = AsObject(pair->at(0), &storage[2 * i]);
+    objs[2 * i + 1] = AsObject(pair->at(1), &storage[2 * i + 1]);
+  }
+  std::vector<uint8_t> equal(num_pairs, 0);
+  ::mlc::WorkerPool::Global()->ParallelFor(num_pairs, [&objs, &equal, bind_free_vars](int64_t i) {
+    thread_local ::mlc::StructuralEqualScratch scratch;
+    try {
+      ::mlc::StructuralEqualImpl(objs[2 * i], objs[2 * i + 1], bind_free_vars, &scratch);
+      equal[i] = 1;
+    } catch (SEqualError &) {
+    }
+  });
+  List<bool> ret;
+  ret.reserve(num_pairs);
+  for (uint8_t e : equal) {
+    ret.push_back(e != 0);
+  }
+  return ret;
+}
+
+void *HashConsNew() { return new ::mlc::HashConsTable(); }
+
+void HashConsDelete(void *table) { delete static_cast<::mlc::HashConsTable *>(table); }
+
+int64_t HashConsSize(void *table) {
+  ::mlc::HashConsTable *self = static_cast<::mlc::HashConsTable *>(table);
+  std::lock_guard<std::mutex> lock(self->mutex);
+  return static_cast<int64_t>(self->buckets.size());
+}
+
+Any HashConsCanonicalize(void *table, AnyView source) {
+  if (::mlc::base::IsTypeIndexPOD(source.type_index)) {
+    return source;
+  }
+  ::mlc::HashConsTable *self = static_cast<::mlc::HashConsTable *>(table);
+  std::lock_guard<std::mutex> lock(self->mutex);
+  return self->Canonicalize(source.operator Object *());
+}
+
+Any HashConsIntern(void *table, AnyView source) {
+  ::mlc::HashConsTable *self = static_cast<::mlc::HashConsTable *>(table);
+  std::lock_guard<std::mutex> lock(self->mutex);
+  return self->Intern(source);
+}
+
+void *StructuralHashMemoNew() { return new ::mlc::StructuralHashMemo<::mlc::Hash64>(); }
+
+void StructuralHashMemoDelete(void *memo) { delete static_cast<::mlc::StructuralHashMemo<::mlc::Hash64> *>(memo); }
+
+int64_t StructuralHashMemoSize(void *memo) {
+  ::mlc::StructuralHashMemo<::mlc::Hash64> *self = static_cast<::mlc::StructuralHashMemo<::mlc::Hash64> *>(memo);
+  std::lock_guard<std::mutex> lock(self->mutex);
+  return static_cast<int64_t>(self->entries.size());
+}
+
+int64_t StructuralHashMemoized(AnyView root, void *memo) {
+  ::mlc::StructuralHashMemo<::mlc::Hash64> *self = static_cast<::mlc::StructuralHashMemo<::mlc::Hash64> *>(memo);
+  Str storage{Null};
+  std::lock_guard<std::mutex> lock(self->mutex);
+  return static_cast<int64_t>(::mlc::StructuralHashImpl<::mlc::Hash64>(AsObject(root, &storage), self));
 }
 
 Any CopyShallow(AnyView source) { return CopyShallowImpl(source); }
 Any CopyDeep(AnyView source) { return CopyDeepImpl(source); }
+Any Rewrite(AnyView root, Func fn) { return RewriteImpl(root, fn.get()); }
 
 Any JSONLoads(AnyView json_str) {
   if (json_str.type_index == kMLCRawStr) {
@@ -1529,6 +4239,54 @@ Any JSONDeserialize(AnyView json_str) {
 
 Str JSONSerialize(AnyView source) { return ::mlc::Serialize(source); }
 
+void JSONSerializeTo(AnyView source, AnyView sink, AnyView tensor_sink) {
+  if (tensor_sink.type_index == kMLCNone) {
+    ::mlc::SerializeTo(source, ::mlc::ToByteSink(sink));
+  } else {
+    ::mlc::ByteSink tensor_byte_sink = ::mlc::ToByteSink(tensor_sink);
+    ::mlc::SerializeTo(source, ::mlc::ToByteSink(sink), &tensor_byte_sink);
+  }
+}
+
+Any JSONDeserializeFrom(int64_t fd, int64_t offset, AnyView tensor_file) {
+  // The JSON parser works on the whole text, so the file is read in one go
+  ::mlc::FileDescriptorSource file{fd};
+  int64_t size = std::max<int64_t>(0, file.Size() - offset);
+  std::string text(static_cast<size_t>(size), '\0');
+  file.ReadAt(offset, reinterpret_cast<uint8_t *>(text.data()), size);
+  return ::mlc::DeserializeWithTensorFile(text.data(), size, tensor_file);
+}
+
+Any JSONDeserializeTensorFile(Str json_str, Str tensor_file) {
+  return ::mlc::DeserializeWithTensorFile(json_str->data(), json_str->size(), tensor_file);
+}
+
+Str BinarySerialize(AnyView source) { return ::mlc::BinarySerialize(source); }
+
+void BinarySerializeTo(AnyView source, AnyView sink) { ::mlc::BinarySerializeTo(source, ::mlc::ToByteSink(sink)); }
+
+Any BinaryDeserializeFrom(int64_t fd, int64_t offset) { return ::mlc::BinaryDeserializeFrom(fd, offset); }
+
+void *MappedBinaryOpen(Str path) { return new ::mlc::MappedBinary(path->data()); }
+
+void MappedBinaryDelete(void *handle) { delete static_cast<::mlc::MappedBinary *>(handle); }
+
+int64_t MappedBinarySize(void *handle) { return static_cast<::mlc::MappedBinary *>(handle)->NumValues(); }
+
+Any MappedBinaryGet(void *handle, int64_t index) { return static_cast<::mlc::MappedBinary *>(handle)->Get(index); }
+
+UList MappedBinaryEntry(void *handle, int64_t index) {
+  return static_cast<::mlc::MappedBinary *>(handle)->Entry(index);
+}
+
+Any BinaryDeserialize(Str source) {
+  return ::mlc::BinaryDeserialize(reinterpret_cast<const uint8_t *>(source->data()), source->size());
+}
+
+Any BinaryDeserializeBytes(void *data, int64_t num_bytes) {
+  return ::mlc::BinaryDeserialize(static_cast<const uint8_t *>(data), num_bytes);
+}
+
 Str TensorToBytes(const TensorObj *src) {
   return ::mlc::TensorToBytes(&src->tensor); //
 }
@@ -2,43 +2,368 @@
 #define MLC_BASE_ALLOC_H_
 
 #include "./utils.h"
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <mutex>
+#include <new>
 #include <type_traits>
+#include <vector>
 
 namespace mlc {
 
+namespace base {
+
+/*!
+ * \brief Per-thread free lists of fixed-size blocks, bucketed by size classes of `kAlignment` bytes.
+ *
+ * Requests larger than `kMaxBytes` fall back to global `operator new`. A block freed on a thread goes to
+ * that thread's free list regardless of where it was allocated. Free lists move to and from a global depot
+ * as whole batches of up to `kBatchBytes`, so that neither side walks a list: a thread keeps the batch it is
+ * filling plus one full batch in reserve per size class, and hands any further full batch, as well as all
+ * blocks of an exiting thread, over to the depot.
+ * Memory is never returned to the system: the depot keeps the peak number of freed blocks for reuse.
+ */
+struct SizeClassPool {
+  static constexpr size_t kAlignment = 16;
+  static constexpr size_t kNumSizeClasses = 16;
+  static constexpr size_t kMaxBytes = kAlignment * kNumSizeClasses;
+  static constexpr size_t kChunkBytes = 64 * 1024;
+  static constexpr size_t kBatchBytes = kChunkBytes;
+
+  MLC_INLINE static void *Alloc(size_t num_bytes) {
+    if (num_bytes > kMaxBytes) {
+      return ::operator new(num_bytes);
+    }
+    size_t size_class = SizeClassOf(num_bytes);
+    Cache *cache = GetCache();
+    FreeList &list = cache->current[size_class];
+    if (Block *block = list.head) {
+      list.head = block->next;
+      --list.num_blocks;
+      return block;
+    }
+    return Refill(cache, size_class);
+  }
+
+  MLC_INLINE static void Free(void *ptr, size_t num_bytes) {
+    if (num_bytes > kMaxBytes) {
+      ::operator delete(ptr);
+      return;
+    }
+    size_t size_class = SizeClassOf(num_bytes);
+    Cache *cache = GetCache();
+    FreeList &list = cache->current[size_class];
+    Block *block = static_cast<Block *>(ptr);
+    block->next = list.head;
+    list.head = block;
+    if (++list.num_blocks >= kBlocksPerBatch[size_class] || cache->exited) {
+      Spill(cache, size_class);
+    }
+  }
+
+  /*! \brief Allocates `num_bytes` whose size is recorded in a `kAlignment`-byte prefix, freed by `FreeSized`. */
+  MLC_INLINE static void *AllocSized(size_t num_bytes) {
+    size_t total = num_bytes + kAlignment;
+    char *block = static_cast<char *>(Alloc(total));
+    *reinterpret_cast<size_t *>(block) = total;
+    return block + kAlignment;
+  }
+
+  MLC_INLINE static void FreeSized(void *ptr) {
+    char *block = static_cast<char *>(ptr) - kAlignment;
+    Free(block, *reinterpret_cast<size_t *>(block));
+  }
+
+  /*! \brief Number of bytes requested from `AllocSized` for `ptr`. */
+  MLC_INLINE static size_t SizeOfSized(const void *ptr) {
+    return *reinterpret_cast<const size_t *>(static_cast<const char *>(ptr) - kAlignment) - kAlignment;
+  }
+
+private:
+  struct Block {
+    Block *next;
+    Block *next_batch; // Only meaningful in the first block of a batch in the depot
+  };
+  static_assert(sizeof(Block) <= kAlignment, "A block must fit in the smallest size class");
+  struct FreeList {
+    Block *head;
+    // An upper bound of the length, as batches from the depot may be partial, e.g. from exiting threads
+    size_t num_blocks;
+  };
+  // Trivially destructible so that it stays usable during thread teardown
+  struct Cache {
+    FreeList current[kNumSizeClasses];
+    Block *reserve[kNumSizeClasses]; // A full batch, or nullptr
+    bool registered;
+    bool exited;
+  };
+  struct Depot {
+    std::mutex mutex;
+    Block *batches[kNumSizeClasses] = {};
+  };
+  struct CacheFlusher {
+    Cache *cache;
+    ~CacheFlusher() {
+      cache->exited = true;
+      for (size_t i = 0; i < kNumSizeClasses; ++i) {
+        Spill(cache, i);
+        if (Block *batch = cache->reserve[i]) {
+          cache->reserve[i] = nullptr;
+          PushBatch(i, batch);
+        }
+      }
+    }
+  };
+
+  MLC_INLINE static size_t SizeClassOf(size_t num_bytes) {
+    return num_bytes == 0 ? 0 : (num_bytes + kAlignment - 1) / kAlignment - 1;
+  }
+  MLC_INLINE static size_t BytesOf(size_t size_class) { return (size_class + 1) * kAlignment; }
+
+  static constexpr size_t kBlocksPerBatch[kNumSizeClasses] = {
+      kBatchBytes / (kAlignment * 1),  kBatchBytes / (kAlignment * 2),  kBatchBytes / (kAlignment * 3),
+      kBatchBytes / (kAlignment * 4),  kBatchBytes / (kAlignment * 5),  kBatchBytes / (kAlignment * 6),
+      kBatchBytes / (kAlignment * 7),  kBatchBytes / (kAlignment * 8),  kBatchBytes / (kAlignment * 9),
+      kBatchBytes / (kAlignment * 10), kBatchBytes / (kAlignment * 11), kBatchBytes / (kAlignment * 12),
+      kBatchBytes / (kAlignment * 13), kBatchBytes / (kAlignment * 14), kBatchBytes / (kAlignment * 15),
+      kBatchBytes / (kAlignment * 16),
+  };
+  static_assert(kBatchBytes <= kChunkBytes, "A new chunk must hold a full batch");
+
+  MLC_INLINE static Cache *GetCache() {
+    static thread_local Cache cache{};
+    if (!cache.registered) {
+      cache.registered = true;
+      static thread_local CacheFlusher flusher{&cache};
+      (void)flusher;
+    }
+    return &cache;
+  }
+
+  static Depot *GetDepot() {
+    static Depot *depot = new Depot(); // Leaked on purpose: threads may exit after static destruction
+    return depot;
+  }
+
+  static void PushBatch(size_t size_class, Block *batch) {
+    Depot *depot = GetDepot();
+    std::lock_guard<std::mutex> lock(depot->mutex);
+    batch->next_batch = depot->batches[size_class];
+    depot->batches[size_class] = batch;
+  }
+
+  static Block *PopBatch(size_t size_class) {
+    Depot *depot = GetDepot();
+    std::lock_guard<std::mutex> lock(depot->mutex);
+    Block *batch = depot->batches[size_class];
+    if (batch != nullptr) {
+      depot->batches[size_class] = batch->next_batch;
+    }
+    return batch;
+  }
+
+  /*! \brief Called when `current[size_class]` is empty: allocates from the reserve, the depot or a new chunk. */
+  static void *Refill(Cache *cache, size_t size_class) {
+    size_t num_blocks = kBlocksPerBatch[size_class];
+    Block *batch = cache->reserve[size_class];
+    if (batch != nullptr) {
+      cache->reserve[size_class] = nullptr;
+    } else if ((batch = PopBatch(size_class)) == nullptr) {
+      size_t block_bytes = BytesOf(size_class);
+      char *chunk = static_cast<char *>(::operator new(kChunkBytes));
+      for (size_t i = num_blocks; i-- > 0;) {
+        Block *block = reinterpret_cast<Block *>(chunk + i * block_bytes);
+        block->next = batch;
+        batch = block;
+      }
+    }
+    if (cache->exited) {
+      // Keeps nothing in the cache of an exiting thread
+      if (Block *rest = batch->next) {
+        PushBatch(size_class, rest);
+      }
+      return batch;
+    }
+    cache->current[size_class] = FreeList{batch->next, num_blocks - 1};
+    return batch;
+  }
+
+  /*! \brief Moves `current[size_class]` as a batch into the reserve, or into the depot if the reserve is taken. */
+  static void Spill(Cache *cache, size_t size_class) {
+    Block *batch = cache->current[size_class].head;
+    if (batch == nullptr) {
+      return;
+    }
+    cache->current[size_class] = FreeList{nullptr, 0};
+    if (!cache->exited && cache->reserve[size_class] == nullptr) {
+      cache->reserve[size_class] = batch;
+    } else {
+      PushBatch(size_class, batch);
+    }
+  }
+};
+
+/*!
+ * \brief Bump-pointer region behind `mlc::Arena`.
+ *
+ * Every allocation is preceded by a `kAlignment`-byte prefix pointing back to its region. A region is
+ * reference counted by its scope and by each object alive in it, and all its chunks are returned at once
+ * when the count drops to zero, so that objects escaping the scope stay valid.
+ */
+struct ArenaState {
+  static constexpr size_t kAlignment = 16;
+  static constexpr size_t kChunkBytes = 64 * 1024;
+
+  explicit ArenaState(ArenaState *prev) : prev(prev) {}
+  ArenaState(const ArenaState &) = delete;
+  ArenaState &operator=(const ArenaState &) = delete;
+  ~ArenaState() {
+    for (void *chunk : this->chunks) {
+      ::operator delete(chunk);
+    }
+  }
+
+  /*! \brief The innermost arena of the calling thread, shared across all libraries via the C API. */
+  MLC_INLINE static ArenaState *Current() { return static_cast<ArenaState *>(*Slot()); }
+  MLC_INLINE static void SetCurrent(ArenaState *state) { *Slot() = state; }
+
+  MLC_INLINE void *Alloc(size_t num_bytes) {
+    size_t total = (num_bytes + 2 * kAlignment - 1) / kAlignment * kAlignment;
+    char *block = this->cur;
+    if (total <= static_cast<size_t>(this->end - this->cur)) {
+      this->cur += total;
+    } else {
+      block = this->AllocSlow(total);
+    }
+    *reinterpret_cast<ArenaState **>(block) = this;
+    this->ref_cnt.fetch_add(1, std::memory_order_relaxed);
+    return block + kAlignment;
+  }
+
+  /*! \brief Releases an allocation. Its memory is only reclaimed together with the entire region. */
+  MLC_INLINE static void Free(void *ptr) {
+    (*reinterpret_cast<ArenaState **>(static_cast<char *>(ptr) - kAlignment))->DecRef();
+  }
+
+  MLC_INLINE void DecRef() {
+    if (this->ref_cnt.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+  ArenaState *prev;
+  std::atomic<int64_t> ref_cnt{1};
+
+private:
+  char *AllocSlow(size_t total) {
+    char *chunk = static_cast<char *>(::operator new(std::max(total, kChunkBytes)));
+    this->chunks.push_back(chunk);
+    if (total > kChunkBytes / 4) { // Large blocks get a dedicated chunk
+      return chunk;
+    }
+    this->cur = chunk + total;
+    this->end = chunk + kChunkBytes;
+    return chunk;
+  }
+
+  static void **Slot() {
+    static thread_local void **slot = ::MLCArenaThreadLocal();
+    return slot;
+  }
+
+  char *cur = nullptr;
+  char *end = nullptr;
+  std::vector<void *> chunks;
+};
+
+} // namespace base
+
+/*!
+ * \brief Allocates objects into an `ArenaState`. Used by the other allocators while an `mlc::Arena` is
+ * active; the deleter still runs the destructor to release references, but never frees memory.
+ */
+template <typename T> struct ArenaObjectAllocator {
+  template <typename... Args>
+  MLC_INLINE_NO_MSVC static T *New(::mlc::base::ArenaState *arena, Args &&...args) {
+    return NewImpl(arena->Alloc(sizeof(T)), std::forward<Args>(args)...);
+  }
+
+  template <typename PadType, typename... Args>
+  MLC_INLINE_NO_MSVC static T *NewWithPad(::mlc::base::ArenaState *arena, size_t pad_size, Args &&...args) {
+    return NewImpl(arena->Alloc(sizeof(T) + pad_size * sizeof(PadType)), std::forward<Args>(args)...);
+  }
+
+  static void Deleter(void *objptr) {
+    T *tptr = static_cast<T *>(objptr);
+    tptr->T::~T();
+    ::mlc::base::ArenaState::Free(tptr);
+  }
+
+private:
+  template <typename... Args> MLC_INLINE_NO_MSVC static T *NewImpl(void *data, Args &&...args) {
+    try {
+      new (data) T(std::forward<Args>(args)...);
+    } catch (...) {
+      ::mlc::base::ArenaState::Free(data);
+      throw;
+    }
+    T *ret = static_cast<T *>(data);
+    ret->_mlc_header.type_index = T::_type_index;
+    ret->_mlc_header.ref_cnt = 0;
+    ret->_mlc_header.v.deleter = ArenaObjectAllocator<T>::Deleter;
+    return ret;
+  }
+};
+
 template <typename T> struct DefaultObjectAllocator {
   using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
 
   template <typename... Args, typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
   MLC_INLINE_NO_MSVC static T *New(Args &&...args) {
-    Storage *data = new Storage;
+    if constexpr (alignof(T) <= ::mlc::base::ArenaState::kAlignment) {
+      if (::mlc::base::ArenaState *arena = ::mlc::base::ArenaState::Current()) {
+        return ArenaObjectAllocator<T>::New(arena, std::forward<Args>(args)...);
+      }
+    }
+    return NewOnHeap(std::forward<Args>(args)...);
+  }
+
+  /*! \brief Allocates on the heap even when an arena is active, for objects that replace their deleter. */
+  template <typename... Args, typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
+  MLC_INLINE_NO_MSVC static T *NewOnHeap(Args &&...args) {
+    Storage *data = AllocStorage(1);
     try {
       new (data) T(std::forward<Args>(args)...);
     } catch (...) {
-      delete data;
+      FreeStorage(data);
       throw;
     }
     T *ret = reinterpret_cast<T *>(data);
     ret->_mlc_header.type_index = T::_type_index;
-    ret->_mlc_header.ref_cnt = 0;
+    ret->_mlc_header.ref_cnt = ::mlc::base::InitRefCnt(ret);
     ret->_mlc_header.v.deleter = DefaultObjectAllocator<T>::Deleter;
     return ret;
   }
 
   template <typename PadType, typename... Args, typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
   MLC_INLINE_NO_MSVC static T *NewWithPad(size_t pad_size, Args &&...args) {
+    if constexpr (alignof(T) <= ::mlc::base::ArenaState::kAlignment) {
+      if (::mlc::base::ArenaState *arena = ::mlc::base::ArenaState::Current()) {
+        return ArenaObjectAllocator<T>::template NewWithPad<PadType>(arena, pad_size, std::forward<Args>(args)...);
+      }
+    }
     size_t num_storages = (sizeof(T) + pad_size * sizeof(PadType) + sizeof(Storage) - 1) / sizeof(Storage);
-    Storage *data = new Storage[num_storages];
+    Storage *data = AllocStorage(num_storages);
     try {
       new (data) T(std::forward<Args>(args)...);
     } catch (...) {
-      delete[] data;
+      FreeStorage(data);
       throw;
     }
     T *ret = reinterpret_cast<T *>(data);
     ret->_mlc_header.type_index = T::_type_index;
-    ret->_mlc_header.ref_cnt = 0;
+    ret->_mlc_header.ref_cnt = ::mlc::base::InitRefCnt(ret);
     ret->_mlc_header.v.deleter = DefaultObjectAllocator<T>::DeleterArray;
     return ret;
   }
@@ -46,14 +371,90 @@ template <typename T> struct DefaultObjectAllocator {
   static void Deleter(void *objptr) {
     T *tptr = static_cast<T *>(objptr);
     tptr->T::~T();
-    delete reinterpret_cast<Storage *>(tptr);
+    FreeStorage(reinterpret_cast<Storage *>(tptr));
+  }
+
+  static void DeleterArray(void *objptr) {
+    T *tptr = static_cast<T *>(objptr);
+    tptr->T::~T();
+    FreeStorage(reinterpret_cast<Storage *>(tptr));
+  }
+
+private:
+  static constexpr size_t kPrefixStorages = (::mlc::base::kObjectPrefixBytes + sizeof(Storage) - 1) / sizeof(Storage);
+
+  MLC_INLINE static Storage *AllocStorage(size_t num_storages) {
+    return new Storage[kPrefixStorages + num_storages] + kPrefixStorages;
+  }
+
+  MLC_INLINE static void FreeStorage(Storage *data) { delete[] (data - kPrefixStorages); }
+};
+
+/*!
+ * \brief A drop-in replacement of `DefaultObjectAllocator` backed by `base::SizeClassPool`, intended for
+ * small objects that are allocated and freed at a high rate. A type opts in via
+ * `using Allocator = ::mlc::PoolObjectAllocator<T>;`.
+ *
+ * Memory of freed objects is kept for reuse by objects of the same size class and never returned to the
+ * system, so the footprint stays at the peak number of objects alive at once.
+ */
+template <typename T> struct PoolObjectAllocator {
+  static_assert(alignof(T) <= ::mlc::base::SizeClassPool::kAlignment, "Over-aligned types cannot be pooled");
+  using Pool = ::mlc::base::SizeClassPool;
+
+  template <typename... Args, typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
+  MLC_INLINE_NO_MSVC static T *New(Args &&...args) {
+    if (::mlc::base::ArenaState *arena = ::mlc::base::ArenaState::Current()) {
+      return ArenaObjectAllocator<T>::New(arena, std::forward<Args>(args)...);
+    }
+    void *data = static_cast<char *>(Pool::Alloc(kNumBytes)) + kPrefix;
+    try {
+      new (data) T(std::forward<Args>(args)...);
+    } catch (...) {
+      Pool::Free(static_cast<char *>(data) - kPrefix, kNumBytes);
+      throw;
+    }
+    T *ret = static_cast<T *>(data);
+    ret->_mlc_header.type_index = T::_type_index;
+    ret->_mlc_header.ref_cnt = ::mlc::base::InitRefCnt(ret);
+    ret->_mlc_header.v.deleter = PoolObjectAllocator<T>::Deleter;
+    return ret;
+  }
+
+  template <typename PadType, typename... Args, typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
+  MLC_INLINE_NO_MSVC static T *NewWithPad(size_t pad_size, Args &&...args) {
+    if (::mlc::base::ArenaState *arena = ::mlc::base::ArenaState::Current()) {
+      return ArenaObjectAllocator<T>::template NewWithPad<PadType>(arena, pad_size, std::forward<Args>(args)...);
+    }
+    void *data = static_cast<char *>(Pool::AllocSized(kNumBytes + pad_size * sizeof(PadType))) + kPrefix;
+    try {
+      new (data) T(std::forward<Args>(args)...);
+    } catch (...) {
+      Pool::FreeSized(static_cast<char *>(data) - kPrefix);
+      throw;
+    }
+    T *ret = static_cast<T *>(data);
+    ret->_mlc_header.type_index = T::_type_index;
+    ret->_mlc_header.ref_cnt = ::mlc::base::InitRefCnt(ret);
+    ret->_mlc_header.v.deleter = PoolObjectAllocator<T>::DeleterArray;
+    return ret;
+  }
+
+  static void Deleter(void *objptr) {
+    T *tptr = static_cast<T *>(objptr);
+    tptr->T::~T();
+    Pool::Free(reinterpret_cast<char *>(tptr) - kPrefix, kNumBytes);
   }
 
   static void DeleterArray(void *objptr) {
     T *tptr = static_cast<T *>(objptr);
     tptr->T::~T();
-    delete[] reinterpret_cast<Storage *>(tptr);
+    Pool::FreeSized(reinterpret_cast<char *>(tptr) - kPrefix);
   }
+
+private:
+  static constexpr size_t kPrefix = ::mlc::base::kObjectPrefixBytes;
+  static constexpr size_t kNumBytes = kPrefix + sizeof(T);
 };
 
 template <typename T> struct PODAllocator;
@@ -61,15 +462,21 @@ template <typename T> struct PODAllocator;
 #define MLC_DEF_POD_ALLOCATOR(Type, TypeIndex, Field)                                                                  \
   template <> struct PODAllocator<Type> {                                                                              \
     MLC_INLINE_NO_MSVC static MLCAny *New(Type data) {                                                                 \
-      MLCBoxedPOD *ret = new MLCBoxedPOD;                                                                              \
+      MLCBoxedPOD *ret = nullptr;                                                                                      \
+      if (::mlc::base::ArenaState *arena = ::mlc::base::ArenaState::Current()) {                                       \
+        ret = static_cast<MLCBoxedPOD *>(arena->Alloc(sizeof(MLCBoxedPOD)));                                           \
+        ret->_mlc_header.v.deleter = ::mlc::base::ArenaState::Free;                                                    \
+      } else {                                                                                                         \
+        ret = static_cast<MLCBoxedPOD *>(::mlc::base::SizeClassPool::Alloc(sizeof(MLCBoxedPOD)));                      \
+        ret->_mlc_header.v.deleter = PODAllocator::Deleter;                                                            \
+      }                                                                                                                \
       ret->_mlc_header.type_index = static_cast<int32_t>(TypeIndex);                                                   \
       ret->_mlc_header.ref_cnt = 0;                                                                                    \
-      ret->_mlc_header.v.deleter = PODAllocator::Deleter;                                                              \
       ret->data.v_int64 = 0;                                                                                           \
       ret->data.Field = data;                                                                                          \
       return reinterpret_cast<MLCAny *>(ret);                                                                          \
     }                                                                                                                  \
-    static void Deleter(void *objptr) { delete static_cast<MLCBoxedPOD *>(objptr); }                                   \
+    static void Deleter(void *objptr) { ::mlc::base::SizeClassPool::Free(objptr, sizeof(MLCBoxedPOD)); }               \
   }
 
 MLC_DEF_POD_ALLOCATOR(bool, MLCTypeIndex::kMLCBool, v_bool);
@@ -82,7 +489,7 @@ MLC_DEF_POD_ALLOCATOR(::mlc::base::VoidPtr, MLCTypeIndex::kMLCPtr, v_ptr);
 #undef MLC_DEF_POD_ALLOCATOR
 
 MLC_INLINE mlc::Object *AllocExternObject(int32_t type_index, int32_t num_bytes) {
-  MLCAny *ptr = reinterpret_cast<MLCAny *>(std::malloc(num_bytes));
+  MLCAny *ptr = reinterpret_cast<MLCAny *>(::mlc::base::SizeClassPool::AllocSized(num_bytes));
   std::memset(ptr, 0, num_bytes);
   ptr->type_index = type_index;
   ptr->ref_cnt = 0;
@@ -90,6 +497,70 @@ MLC_INLINE mlc::Object *AllocExternObject(int32_t type_index, int32_t num_bytes)
   return reinterpret_cast<mlc::Object *>(ptr);
 }
 
+/*! \brief Whether `obj` is created by `AllocExternObject`, i.e. it is an instance of a Python-defined class. */
+MLC_INLINE bool IsExternObject(const mlc::Object *obj) {
+  return reinterpret_cast<const MLCAny *>(obj)->v.deleter == MLCExtObjDelete;
+}
+
+MLC_INLINE int32_t ExternObjectNumBytes(const mlc::Object *obj) {
+  return static_cast<int32_t>(::mlc::base::SizeClassPool::SizeOfSized(obj));
+}
+
+/*!
+ * \brief Scoped region allocation for transient object graphs.
+ *
+ * While an arena is the innermost one of the calling thread, objects created through the standard
+ * allocators (`DefaultObjectAllocator`, `PoolObjectAllocator`, `PODAllocator`) are bump-allocated from it.
+ * Freeing such an object only runs its destructor, and the whole region is returned at once after the scope
+ * ends. Objects still alive when the scope ends are considered escaped: they remain valid and keep the
+ * region alive until the last of them dies. Extern objects are never allocated in an arena.
+ *
+ * Unlike `PoolObjectAllocator`, which keeps freed memory cached for the lifetime of the process, a region
+ * returns its chunks to the system as a whole.
+ *
+ * Arenas nest and must be exited in reverse order of entering on the thread that entered them.
+ */
+struct Arena {
+  Arena() : state(new ::mlc::base::ArenaState(::mlc::base::ArenaState::Current())) {
+    ::mlc::base::ArenaState::SetCurrent(this->state);
+  }
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+  ~Arena() {
+    if (this->state != nullptr) {
+      this->ExitImpl();
+    }
+  }
+
+  /*! \brief Number of objects alive in the arena, or the number that escaped once it is exited. */
+  int64_t NumLive() const {
+    return this->state ? this->state->ref_cnt.load(std::memory_order_relaxed) - 1 : this->num_escaped;
+  }
+
+  /*! \brief Ends the scope early and returns the number of escaped objects. */
+  int64_t Exit() {
+    if (this->state == nullptr) {
+      MLC_THROW(ValueError) << "Arena has already been exited";
+    }
+    if (::mlc::base::ArenaState::Current() != this->state) {
+      MLC_THROW(ValueError) << "Arenas must be exited in reverse order of entering, on the same thread";
+    }
+    return this->ExitImpl();
+  }
+
+private:
+  int64_t ExitImpl() {
+    ::mlc::base::ArenaState::SetCurrent(this->state->prev);
+    this->num_escaped = this->state->ref_cnt.load(std::memory_order_relaxed) - 1;
+    this->state->DecRef();
+    this->state = nullptr;
+    return this->num_escaped;
+  }
+
+  ::mlc::base::ArenaState *state;
+  int64_t num_escaped = 0;
+};
+
 } // namespace mlc
 
 #endif // MLC_BASE_ALLOC_H_
@@ -200,9 +200,14 @@ protected:
   }
   MLC_INLINE void SwitchFromRawStr() {
     if (this->type_index == static_cast<int32_t>(MLCTypeIndex::kMLCRawStr)) {
-      this->type_index = static_cast<int32_t>(MLCTypeIndex::kMLCStr);
-      this->v.v_obj =
-          reinterpret_cast<MLCAny *>(::mlc::base::StrCopyFromCharArray(this->v.v_str, std::strlen(this->v.v_str)));
+      const char *str = this->v.v_str;
+      size_t length = std::strlen(str);
+      if (length <= static_cast<size_t>(::mlc::base::kSmallStrMaxLen)) {
+        ::mlc::base::SmallStrFromCharArray(str, static_cast<int64_t>(length), this);
+      } else {
+        this->type_index = static_cast<int32_t>(MLCTypeIndex::kMLCStr);
+        this->v.v_obj = reinterpret_cast<MLCAny *>(::mlc::base::StrCopyFromCharArray(str, length));
+      }
     }
   }
 };
@@ -36,6 +36,8 @@ template <typename, typename> struct Dict;
 
 template <typename T, typename... Args> Ref<Object> InitOf(Args &&...args);
 template <typename T> struct DefaultObjectAllocator;
+template <typename T> struct PoolObjectAllocator;
+template <typename T> struct ArenaObjectAllocator;
 template <typename T> struct PODAllocator;
 
 enum class StructureKind : int32_t {
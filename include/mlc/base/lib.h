@@ -30,7 +30,9 @@ struct Lib {
   static FuncObj *FuncGetGlobal(const char *name, bool allow_missing = false);
   static ::mlc::Str CxxStr(AnyView obj);
   static ::mlc::Str Str(AnyView obj);
+  static ::mlc::Str StrIntern(AnyView source);
   static Any IRPrint(AnyView obj, AnyView printer, AnyView path);
+  static Any Rewrite(AnyView root, FuncObj *fn);
   static const char *DeviceTypeToStr(int32_t device_type);
   static int32_t DeviceTypeFromStr(const char *source);
   static void DeviceTypeRegister(const char *name);
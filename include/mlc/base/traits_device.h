@@ -32,6 +32,9 @@ template <> struct TypeTraits<DLDevice> {
     if (ty == MLCTypeIndex::kMLCStr) {
       return DeviceFromStr(reinterpret_cast<const MLCStr *>(v->v.v_obj)->data);
     }
+    if (ty == MLCTypeIndex::kMLCSmallStr) {
+      return DeviceFromStr(v->v.v_bytes);
+    }
     throw TemporaryTypeError();
   }
 
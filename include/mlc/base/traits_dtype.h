@@ -40,6 +40,9 @@ template <> struct TypeTraits<DLDataType> {
     if (ty == MLCTypeIndex::kMLCStr) {
       return DataTypeFromStr(reinterpret_cast<const MLCStr *>(v->v.v_obj)->data);
     }
+    if (ty == MLCTypeIndex::kMLCSmallStr) {
+      return DataTypeFromStr(v->v.v_bytes);
+    }
     throw TemporaryTypeError();
   }
 
@@ -33,7 +33,15 @@ template <typename T> struct ObjPtrTraitsDefault {
 template <typename T> struct TypeTraits<T *, std::enable_if_t<IsObj<T> && !IsTemplate<T>>> {
   MLC_INLINE static void TypeToAny(T *src, MLCAny *ret) { ObjPtrTraitsDefault<T>::TypeToAny(src, ret); }
   MLC_INLINE static T *AnyToTypeUnowned(const MLCAny *v) { return ObjPtrTraitsDefault<T>::AnyToTypeUnowned(v); }
-  MLC_INLINE static T *AnyToTypeOwned(const MLCAny *v) { return ObjPtrTraitsDefault<T>::AnyToTypeOwned(v); }
+  MLC_INLINE static T *AnyToTypeOwned(const MLCAny *v) {
+    if constexpr (std::is_same_v<T, Object>) {
+      if (v->type_index == static_cast<int32_t>(MLCTypeIndex::kMLCSmallStr)) {
+        // Small strings are boxed into a heap-allocated `StrObj` when viewed as an object
+        return reinterpret_cast<T *>(StrCopyFromCharArray(v->v.v_bytes, static_cast<size_t>(v->small_len)));
+      }
+    }
+    return ObjPtrTraitsDefault<T>::AnyToTypeOwned(v);
+  }
 };
 
 template <typename E> struct TypeTraits<ListObj<E> *> {
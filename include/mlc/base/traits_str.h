@@ -22,6 +22,10 @@ template <> struct TypeTraits<const char *> {
     if (ty == MLCTypeIndex::kMLCStr) {
       return reinterpret_cast<MLCStr *>(v->v.v_obj)->data;
     }
+    if (ty == MLCTypeIndex::kMLCSmallStr) {
+      // Points into `v` itself, which is valid as long as `v` is alive
+      return v->v.v_bytes;
+    }
     throw TemporaryTypeError();
   }
   static const char *AnyToTypeUnowned(const MLCAny *v) { return AnyToTypeOwned(v); }
@@ -4,10 +4,15 @@
 #ifndef MLC_DEBUG_MODE
 #define MLC_DEBUG_MODE 0
 #endif
+#ifndef MLC_BIASED_REFCOUNT
+#define MLC_BIASED_REFCOUNT 0
+#endif
 
 #ifdef _MSC_VER
 #include <intrin.h>
 #pragma intrinsic(_BitScanReverse64)
+#pragma intrinsic(_BitScanForward)
+#pragma intrinsic(_BitScanForward64)
 #pragma intrinsic(_InterlockedIncrement)
 #pragma intrinsic(_InterlockedDecrement)
 #endif
@@ -23,6 +28,9 @@
 #if MLC_DEBUG_MODE == 1
 #include <iostream>
 #endif
+#if MLC_BIASED_REFCOUNT == 1
+#include <atomic>
+#endif
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -125,6 +133,13 @@ MLC_INLINE bool IsTypeIndexPOD(int32_t type_index) {
   return type_index < static_cast<int32_t>(MLCTypeIndex::kMLCStaticObjectBegin);
 }
 
+MLC_INLINE bool IsTypeIndexStr(int32_t type_index) {
+  return type_index == static_cast<int32_t>(MLCTypeIndex::kMLCStr) ||
+         type_index == static_cast<int32_t>(MLCTypeIndex::kMLCSmallStr);
+}
+
+constexpr int64_t kSmallStrMaxLen = sizeof(MLCPODValueUnion::v_bytes) - 1;
+
 template <typename _T> struct Type2Str {
   using T = RemoveCR<_T>;
   static std::string Run() {
@@ -173,8 +188,267 @@ template <typename _T> struct Type2Str {
   }
 };
 
-MLC_INLINE void IncRef(MLCAny *obj) {
+// Trivially destructible so that it stays usable during thread teardown
+struct PendingFree {
+  static constexpr int64_t kInlineCapacity = 64;
+  MLCAny *inline_stack[kInlineCapacity];
+  MLCAny **stack;
+  int64_t size;
+  int64_t capacity;
+  bool draining;
+
+  MLC_INLINE static PendingFree *Get() {
+    static thread_local PendingFree pending{};
+    return &pending;
+  }
+
+  void Push(MLCAny *obj) {
+    if (this->stack == nullptr) {
+      this->stack = this->inline_stack;
+      this->capacity = kInlineCapacity;
+    } else if (this->size == this->capacity) {
+      MLCAny **new_stack = static_cast<MLCAny **>(std::malloc(sizeof(MLCAny *) * this->capacity * 2));
+      if (new_stack == nullptr) {
+        std::abort(); // Out of memory while releasing objects: nothing sensible to do
+      }
+      std::memcpy(new_stack, this->stack, sizeof(MLCAny *) * this->size);
+      if (this->stack != this->inline_stack) {
+        std::free(this->stack);
+      }
+      this->stack = new_stack;
+      this->capacity *= 2;
+    }
+    this->stack[this->size++] = obj;
+  }
+};
+
+/*!
+ * \brief Runs the deleter of `obj` and, iteratively, of every object released by it.
+ *
+ * Objects whose reference count drops to zero inside a deleter are queued on a per-thread stack rather than
+ * freed recursively, so that releasing a long chain of objects does not recurse through destructors.
+ */
+inline void DrainFree(MLCAny *obj) {
+  PendingFree *pending = PendingFree::Get();
+  if (pending->draining) {
+    pending->Push(obj);
+    return;
+  }
+  pending->draining = true;
+  obj->v.deleter(obj);
+  while (pending->size > 0) {
+    obj = pending->stack[--pending->size];
+    obj->v.deleter(obj);
+  }
+  if (pending->stack != pending->inline_stack) {
+    std::free(pending->stack);
+  }
+  pending->stack = nullptr;
+  pending->capacity = 0;
+  pending->draining = false;
+}
+
+/*!
+ * \brief Frees an object whose reference count has dropped to zero. The outermost release on a thread is
+ * handed over to the background reclamation thread when it is enabled.
+ */
+MLC_INLINE void FreeObject(MLCAny *obj) {
+  static MLCReclaimer *reclaimer = ::MLCGetReclaimer();
+#ifdef _MSC_VER
+  int32_t enabled = *reinterpret_cast<volatile int32_t *>(&reclaimer->enabled);
+#else
+  int32_t enabled = __atomic_load_n(&reclaimer->enabled, __ATOMIC_RELAXED);
+#endif
+  if (enabled && !PendingFree::Get()->draining) {
+    reclaimer->submit(obj);
+  } else {
+    DrainFree(obj);
+  }
+}
+
+/*!
+ * \brief Reference count assigned to immortal objects, whose reference counts are never touched again.
+ * Any count at or above half of it is treated as immortal, so that updates racing with `MarkImmortal`
+ * cannot bring an object back to mortality.
+ */
+constexpr int32_t kImmortalRefCnt = 0x40000000;
+
+#if MLC_BIASED_REFCOUNT == 1
+/*!
+ * \brief Biased reference counting, enabled by building with `MLC_BIASED_REFCOUNT=1`.
+ *
+ * Objects from `DefaultObjectAllocator` and `PoolObjectAllocator` are owned by the thread allocating them,
+ * and carry a `BiasedRefCnt` right in front of their header, whose `ref_cnt` is pinned to `kBiasedRefCnt`.
+ * The owner counts references in a plain integer, while other threads count theirs atomically in `shared`,
+ * which may go negative when references handed over by the owner are dropped elsewhere. In that case the
+ * object is queued to its owner, who merges its local count into `shared` and stops being the owner.
+ * The object is freed once it is merged and `shared` drops to zero.
+ *
+ * Owners merge their queues when they next allocate, and when they exit. Threads that hand what they build
+ * over to others and then sit idle, such as worker pools, call `BiasedDisown` so that their objects are
+ * counted atomically instead, rather than waiting in their queues.
+ */
+constexpr int32_t kBiasedRefCnt = 0x10000000;
+
+struct BiasedRefCnt {
+  static constexpr uint32_t kMerged = 1; // The local count has been merged into the shared one
+  static constexpr uint32_t kQueued = 2; // Queued for its owner to merge
+  static constexpr uint32_t kOne = 4;    // The shared count is stored above the flags
+
+  std::atomic<MLCBiasedThread *> owner;
+  int32_t local;
+  std::atomic<uint32_t> shared;
+
+  MLC_INLINE static BiasedRefCnt *Of(MLCAny *obj) { return reinterpret_cast<BiasedRefCnt *>(obj) - 1; }
+  MLC_INLINE static bool IsNegative(uint32_t shared) { return static_cast<int32_t>(shared) < 0; }
+};
+static_assert(sizeof(BiasedRefCnt) == 16, "BiasedRefCnt must fit in 16 bytes");
+
+MLC_INLINE MLCBiasedThread *CurrentBiasedThread() {
+  static thread_local MLCBiasedThread *self = ::MLCBiasedThreadGet();
+  return self;
+}
+
+MLC_INLINE bool IsBiased(const MLCAny *obj) { return obj->ref_cnt == kBiasedRefCnt; }
+
+/*! \brief Stops the current thread from owning the objects it allocates from now on. */
+inline void BiasedDisown() { CurrentBiasedThread()->owning = 0; }
+
+inline void BiasedMerge(MLCAny *obj, bool from_queue) {
+  BiasedRefCnt *rc = BiasedRefCnt::Of(obj);
+  uint32_t delta = 0;
+  if (rc->owner.load(std::memory_order_relaxed) != nullptr) {
+    delta = static_cast<uint32_t>(rc->local) * BiasedRefCnt::kOne + BiasedRefCnt::kMerged;
+    rc->local = 0;
+    rc->owner.store(nullptr, std::memory_order_relaxed);
+  }
+  if (from_queue) {
+    delta -= BiasedRefCnt::kQueued;
+  }
+  if (rc->shared.fetch_add(delta, std::memory_order_acq_rel) + delta == BiasedRefCnt::kMerged) {
+    FreeObject(obj);
+  }
+}
+
+MLC_INLINE void BiasedIncRef(MLCAny *obj) {
+  BiasedRefCnt *rc = BiasedRefCnt::Of(obj);
+  if (rc->owner.load(std::memory_order_relaxed) == CurrentBiasedThread()) {
+    ++rc->local;
+  } else {
+    rc->shared.fetch_add(BiasedRefCnt::kOne, std::memory_order_relaxed);
+  }
+}
+
+MLC_INLINE void BiasedDecRef(MLCAny *obj) {
+  BiasedRefCnt *rc = BiasedRefCnt::Of(obj);
+  MLCBiasedThread *owner = rc->owner.load(std::memory_order_relaxed);
+  if (owner == CurrentBiasedThread()) {
+    if (--rc->local == 0) {
+      BiasedMerge(obj, false);
+    }
+    return;
+  }
+  uint32_t old_value = rc->shared.load(std::memory_order_relaxed);
+  uint32_t new_value;
+  do {
+    new_value = old_value - BiasedRefCnt::kOne;
+    if (BiasedRefCnt::IsNegative(new_value) && !(new_value & (BiasedRefCnt::kMerged | BiasedRefCnt::kQueued))) {
+      new_value |= BiasedRefCnt::kQueued;
+    }
+  } while (!rc->shared.compare_exchange_weak(old_value, new_value, std::memory_order_acq_rel,
+                                             std::memory_order_relaxed));
+  if (new_value == BiasedRefCnt::kMerged) {
+    FreeObject(obj);
+  } else if ((new_value & BiasedRefCnt::kQueued) && !(old_value & BiasedRefCnt::kQueued)) {
+    // The owner cannot have merged yet, because its local count is still positive
+    ::MLCBiasedThreadQueue(rc->owner.load(std::memory_order_relaxed), obj);
+  }
+}
+
+/*! \brief Sets up the biased count in front of a newly allocated object, and returns its `ref_cnt`. */
+inline int32_t BiasedInit(void *objptr) {
+  MLCBiasedThread *self = CurrentBiasedThread();
+#ifdef _MSC_VER
+  int32_t has_queued = *reinterpret_cast<volatile int32_t *>(&self->has_queued);
+#else
+  int32_t has_queued = __atomic_load_n(&self->has_queued, __ATOMIC_RELAXED);
+#endif
+  if (has_queued) {
+    ::MLCBiasedThreadFlush();
+  }
+  BiasedRefCnt *rc = static_cast<BiasedRefCnt *>(objptr) - 1;
+  rc->owner.store(self, std::memory_order_relaxed);
+  rc->local = 0;
+  rc->shared.store(0, std::memory_order_relaxed);
+  // Objects allocated by disowning threads, or while the thread is being torn down, fall back to atomic
+  // reference counting
+  return self->alive && self->owning ? kBiasedRefCnt : 0;
+}
+#endif
+
+/*! \brief Number of references to an object, which is exact only when no other thread is updating it. */
+MLC_INLINE int32_t RefCount(const MLCAny *obj) {
+#if MLC_BIASED_REFCOUNT == 1
+  if (IsBiased(obj)) {
+    const BiasedRefCnt *rc = BiasedRefCnt::Of(const_cast<MLCAny *>(obj));
+    uint32_t shared = rc->shared.load(std::memory_order_relaxed) & ~(BiasedRefCnt::kMerged | BiasedRefCnt::kQueued);
+    return rc->local + static_cast<int32_t>(shared) / static_cast<int32_t>(BiasedRefCnt::kOne);
+  }
+#endif
+  return obj->ref_cnt;
+}
+
+/*! \brief Number of bytes in front of each object from `DefaultObjectAllocator` or `PoolObjectAllocator`. */
+#if MLC_BIASED_REFCOUNT == 1
+constexpr size_t kObjectPrefixBytes = sizeof(BiasedRefCnt);
+#else
+constexpr size_t kObjectPrefixBytes = 0;
+#endif
+
+/*! \brief Initial `ref_cnt` of an object from `DefaultObjectAllocator` or `PoolObjectAllocator`. */
+MLC_INLINE int32_t InitRefCnt([[maybe_unused]] void *objptr) {
+#if MLC_BIASED_REFCOUNT == 1
+  return BiasedInit(objptr);
+#else
+  return 0;
+#endif
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC reports bogus out-of-bounds accesses when these are inlined into `Any` holding a POD value
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#pragma GCC diagnostic ignored "-Wstringop-overflow"
+#endif
+
+MLC_INLINE bool IsImmortal(const MLCAny *obj) {
+#ifdef _MSC_VER
+  int32_t ref_cnt = *reinterpret_cast<const volatile int32_t *>(&obj->ref_cnt);
+#else
+  int32_t ref_cnt = __atomic_load_n(&obj->ref_cnt, __ATOMIC_RELAXED);
+#endif
+  return ref_cnt >= kImmortalRefCnt / 2;
+}
+
+/*! \brief Makes an object live forever and skips atomic reference counting on it from then on. */
+MLC_INLINE void MarkImmortal(MLCAny *obj) {
   if (obj != nullptr) {
+#ifdef _MSC_VER
+    _InterlockedExchange(reinterpret_cast<volatile long *>(&obj->ref_cnt), kImmortalRefCnt);
+#else
+    __atomic_store_n(&obj->ref_cnt, kImmortalRefCnt, __ATOMIC_RELAXED);
+#endif
+  }
+}
+
+MLC_INLINE void IncRef(MLCAny *obj) {
+  if (obj != nullptr && !IsImmortal(obj)) {
+#if MLC_BIASED_REFCOUNT == 1
+    if (IsBiased(obj)) {
+      BiasedIncRef(obj);
+      return;
+    }
+#endif
 #ifdef _MSC_VER
     _InterlockedIncrement(reinterpret_cast<volatile long *>(&obj->ref_cnt));
 #else
@@ -196,7 +470,7 @@ MLC_INLINE void IncRef(MLCAny *obj) {
 }
 
 MLC_INLINE void DecRef(MLCAny *obj) {
-  if (obj != nullptr) {
+  if (obj != nullptr && !IsImmortal(obj)) {
 #if MLC_DEBUG_MODE == 1
     {
       int32_t type_index = obj->type_index;
@@ -210,17 +484,27 @@ MLC_INLINE void DecRef(MLCAny *obj) {
       }
     }
 #endif
+#if MLC_BIASED_REFCOUNT == 1
+    if (IsBiased(obj)) {
+      BiasedDecRef(obj);
+      return;
+    }
+#endif
 #ifdef _MSC_VER
     int32_t ref_cnt = _InterlockedDecrement(reinterpret_cast<volatile long *>(&obj->ref_cnt)) + 1;
 #else
     int32_t ref_cnt = __atomic_fetch_sub(&obj->ref_cnt, 1, __ATOMIC_ACQ_REL);
 #endif
     if (ref_cnt == 1 && obj->v.deleter) {
-      obj->v.deleter(obj);
+      FreeObject(obj);
     }
   }
 }
 
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
 MLC_INLINE int32_t CountLeadingZeros(uint64_t x) {
 #if __cplusplus >= 202002L
   return std::countl_zero(x);
@@ -236,6 +520,36 @@ MLC_INLINE int32_t CountLeadingZeros(uint64_t x) {
 #endif
 }
 
+MLC_INLINE int32_t CountTrailingZeros(uint32_t x) {
+#if __cplusplus >= 202002L
+  return std::countr_zero(x);
+#elif defined(_MSC_VER)
+  unsigned long trailing_zero = 0;
+  if (_BitScanForward(&trailing_zero, x)) {
+    return static_cast<int32_t>(trailing_zero);
+  } else {
+    return 32;
+  }
+#else
+  return x == 0 ? 32 : __builtin_ctz(x);
+#endif
+}
+
+MLC_INLINE int32_t CountTrailingZeros(uint64_t x) {
+#if __cplusplus >= 202002L
+  return std::countr_zero(x);
+#elif defined(_MSC_VER)
+  unsigned long trailing_zero = 0;
+  if (_BitScanForward64(&trailing_zero, x)) {
+    return static_cast<int32_t>(trailing_zero);
+  } else {
+    return 64;
+  }
+#else
+  return x == 0 ? 64 : __builtin_ctzll(x);
+#endif
+}
+
 MLC_INLINE uint64_t BitCeil(uint64_t x) {
 #if __cplusplus >= 202002L
   return std::bit_ceil(x);
@@ -318,10 +632,62 @@ inline uint64_t StrHash(const char *str) {
   return StrHash(str, length);
 }
 
+/*!
+ * \brief The hash cached in `str`, or 0 if it is not computed yet. The cache is read and written atomically, because
+ * strings are shared between threads that hash them concurrently.
+ */
+MLC_INLINE uint64_t StrHashCached(const MLCStr *str) {
+#ifdef _MSC_VER
+  return *reinterpret_cast<const volatile uint64_t *>(&str->hash);
+#else
+  return __atomic_load_n(&str->hash, __ATOMIC_RELAXED);
+#endif
+}
+
+inline uint64_t StrHash(const MLCStr *str) {
+  // The hash is computed at most once per string, unless threads race on the first computation, in which case they
+  // all store the same value with a relaxed atomic store
+  uint64_t hash = StrHashCached(str);
+  if (hash == 0) {
+    hash = StrHash(str->data, str->length);
+#ifdef _MSC_VER
+    *reinterpret_cast<volatile uint64_t *>(&const_cast<MLCStr *>(str)->hash) = hash;
+#else
+    __atomic_store_n(&const_cast<MLCStr *>(str)->hash, hash, __ATOMIC_RELAXED);
+#endif
+  }
+  return hash;
+}
+
+MLC_INLINE void SmallStrFromCharArray(const char *source, int64_t length, MLCAny *ret) {
+  // Requires `length <= kSmallStrMaxLen`. Padding is zeroed so that two small strings
+  // compare equal iff their `v_int64` payloads are equal.
+  ret->type_index = static_cast<int32_t>(MLCTypeIndex::kMLCSmallStr);
+  ret->small_len = static_cast<int32_t>(length);
+  ret->v.v_int64 = 0;
+  std::memcpy(ret->v.v_bytes, source, static_cast<size_t>(length));
+}
+
+MLC_INLINE bool AnyStrView(const MLCAny &a, const char **data, int64_t *length) {
+  if (a.type_index == static_cast<int32_t>(MLCTypeIndex::kMLCSmallStr)) {
+    *data = a.v.v_bytes;
+    *length = a.small_len;
+    return true;
+  } else if (a.type_index == static_cast<int32_t>(MLCTypeIndex::kMLCStr)) {
+    const MLCStr *str = reinterpret_cast<const MLCStr *>(a.v.v_obj);
+    *data = str->data;
+    *length = str->length;
+    return true;
+  }
+  return false;
+}
+
 inline uint64_t AnyHash(const MLCAny &a) {
   if (a.type_index == static_cast<int32_t>(MLCTypeIndex::kMLCStr)) {
-    const MLCStr *str = reinterpret_cast<MLCStr *>(a.v.v_obj);
-    return ::mlc::base::StrHash(str->data, str->length);
+    return ::mlc::base::StrHash(reinterpret_cast<const MLCStr *>(a.v.v_obj));
+  } else if (a.type_index == static_cast<int32_t>(MLCTypeIndex::kMLCSmallStr)) {
+    // Must agree with the hash of a heap-allocated string with the same content
+    return ::mlc::base::StrHash(a.v.v_bytes, a.small_len);
   }
   union {
     int64_t i64;
@@ -333,13 +699,30 @@ inline uint64_t AnyHash(const MLCAny &a) {
 
 inline bool AnyEqual(const MLCAny &a, const MLCAny &b) {
   if (a.type_index != b.type_index) {
+    // A small string may be equal to a heap-allocated string with the same content
+    const char *a_data = nullptr, *b_data = nullptr;
+    int64_t a_len = 0, b_len = 0;
+    if (AnyStrView(a, &a_data, &a_len) && AnyStrView(b, &b_data, &b_len)) {
+      return ::mlc::base::StrCompare(a_data, b_data, a_len, b_len) == 0;
+    }
     return false;
   }
   if (a.type_index == static_cast<int32_t>(MLCTypeIndex::kMLCStr)) {
     const MLCStr *str_a = reinterpret_cast<MLCStr *>(a.v.v_obj);
     const MLCStr *str_b = reinterpret_cast<MLCStr *>(b.v.v_obj);
+    if (str_a == str_b) {
+      return true;
+    }
+    uint64_t hash_a = StrHashCached(str_a);
+    uint64_t hash_b = StrHashCached(str_b);
+    if (hash_a != 0 && hash_b != 0 && hash_a != hash_b) {
+      return false;
+    }
     return ::mlc::base::StrCompare(str_a->data, str_b->data, str_a->length, str_b->length) == 0;
   }
+  if (a.type_index == static_cast<int32_t>(MLCTypeIndex::kMLCSmallStr)) {
+    return a.small_len == b.small_len && a.v.v_int64 == b.v.v_int64;
+  }
   return a.v.v_int64 == b.v.v_int64;
 }
 
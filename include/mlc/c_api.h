@@ -66,6 +66,10 @@ typedef enum {
   // invariant holds:
   // - `Any::type_index` is never `kMLCRawStr`
   // - `AnyView::type_index` can be `kMLCRawStr`
+  // N.B. `kMLCSmallStr` is a string of at most 7 bytes stored inline in
+  // `MLCAny::v.v_bytes` (`\0`-terminated, zero-padded) with its length in
+  // `MLCAny::small_len`. It is never reference counted, and it is produced
+  // when a `kMLCRawStr` short enough is converted to `Any`.
   kMLCNone = 0,
   kMLCBool = 1,
   kMLCInt = 2,
@@ -74,6 +78,7 @@ typedef enum {
   kMLCDataType = 5,
   kMLCDevice = 6,
   kMLCRawStr = 7,
+  kMLCSmallStr = 8,
   kMLCStaticObjectBegin = 1000,
   // kMLCCore [1000: 1100) {
   kMLCCoreBegin = 1000,
@@ -156,6 +161,7 @@ typedef struct {
   MLCAny _mlc_header;
   int64_t length;
   char *data;
+  uint64_t hash; // lazily computed hash of `data`, 0 if not computed yet
 } MLCStr;
 
 typedef struct {
@@ -240,6 +246,42 @@ typedef struct {
   int32_t kind; // 0: member method; 1: static method
 } MLCTypeMethod;
 
+typedef enum {
+  kMLCVisitEnd = 0,
+  // Fields that own a reference
+  kMLCVisitAny = 1,
+  kMLCVisitObjectRef = 2,
+  kMLCVisitOptionalObjectRef = 3,
+  kMLCVisitOptionalBool = 4,
+  kMLCVisitOptionalInt64 = 5,
+  kMLCVisitOptionalFloat64 = 6,
+  kMLCVisitOptionalPtr = 7,
+  kMLCVisitOptionalDataType = 8,
+  kMLCVisitOptionalDevice = 9,
+  // Plain-old-data fields
+  kMLCVisitBool = 10,
+  kMLCVisitInt8 = 11,
+  kMLCVisitInt16 = 12,
+  kMLCVisitInt32 = 13,
+  kMLCVisitInt64 = 14,
+  kMLCVisitFloat32 = 15,
+  kMLCVisitFloat64 = 16,
+  kMLCVisitPtr = 17,
+  kMLCVisitDataType = 18,
+  kMLCVisitDevice = 19,
+  kMLCVisitRawStr = 20,
+  // Fields that cannot be visited, reported when visited
+  kMLCVisitUnsupportedPtr = 21,
+  kMLCVisitUnsupported = 22,
+} MLCVisitOpKind;
+
+typedef struct {
+  int32_t kind;       // MLCVisitOpKind
+  int32_t field_kind; // StructureFieldKind, only used in `MLCTypeInfo::structure_plan`
+  int64_t offset;
+  MLCTypeField *field;
+} MLCVisitOp;
+
 typedef struct MLCTypeInfo {
   int32_t type_index;
   const char *type_key;
@@ -261,8 +303,29 @@ typedef struct MLCTypeInfo {
    * sub_structure_kind = StructureFieldKind::kBind;
    */
   int32_t *sub_structure_kinds; // Ends with -1
+  /*
+   * Visitation plans compiled by the type table whenever fields or structure change, each ending with
+   * an op of kind `kMLCVisitEnd`:
+   * - field_plan: all fields, in the order of `fields`;
+   * - ref_plan: only the fields that own a reference, in the order of `fields`;
+   * - structure_plan: sub-structure fields, in the order of `sub_structure_indices`.
+   */
+  MLCVisitOp *field_plan;
+  MLCVisitOp *ref_plan;
+  MLCVisitOp *structure_plan;
 } MLCTypeInfo;
 
+typedef struct {
+  int32_t enabled;             // Whether garbage is handed over to the background reclamation thread
+  void (*submit)(MLCAny *obj); // Queues an object whose reference count has dropped to zero
+} MLCReclaimer;
+
+typedef struct {
+  int32_t alive;      // Whether the thread is still running
+  int32_t has_queued; // Whether other threads have queued objects for this thread to merge
+  int32_t owning;     // Whether the thread owns the objects it allocates
+} MLCBiasedThread;
+
 typedef void *MLCTypeTableHandle;
 typedef void *MLCVTableHandle;
 MLC_API MLCAny MLCGetLastError();
@@ -295,6 +358,11 @@ MLC_API int32_t MLCErrorGetInfo(MLCAny error, int32_t *num_strs, const char ***s
 MLC_API MLCByteArray MLCTraceback(const char *filename, const char *lineno, const char *func_name);
 MLC_API int32_t MLCExtObjCreate(int32_t num_bytes, int32_t type_index, MLCAny *ret);
 MLC_API void MLCExtObjDelete(void *objptr);
+MLC_API void **MLCArenaThreadLocal();
+MLC_API MLCReclaimer *MLCGetReclaimer();
+MLC_API MLCBiasedThread *MLCBiasedThreadGet();
+MLC_API void MLCBiasedThreadQueue(MLCBiasedThread *owner, MLCAny *obj);
+MLC_API void MLCBiasedThreadFlush();
 #ifdef __cplusplus
 } // MLC_EXTERN_C
 #endif
@@ -91,6 +91,7 @@ MLC_INLINE void DeleteExternObject(Object *objptr) {
       MLC_INLINE void operator()(MLCTypeField *, Optional<DLDevice> *opt) { opt->Reset(); }
       MLC_INLINE void operator()(MLCTypeField *, Optional<DLDataType> *opt) { opt->Reset(); }
       MLC_INLINE void operator()(MLCTypeField *, Optional<void *> *opt) { opt->Reset(); }
+      // Never called, as plain-old-data fields are not in the reference plan
       MLC_INLINE void operator()(MLCTypeField *, bool *) {}
       MLC_INLINE void operator()(MLCTypeField *, int8_t *) {}
       MLC_INLINE void operator()(MLCTypeField *, int16_t *) {}
@@ -103,8 +104,8 @@ MLC_INLINE void DeleteExternObject(Object *objptr) {
       MLC_INLINE void operator()(MLCTypeField *, DLDevice *) {}
       MLC_INLINE void operator()(MLCTypeField *, const char **) {}
     };
-    VisitFields(objptr, info, ExternObjDeleter{});
-    std::free(objptr);
+    VisitFieldRefs(objptr, info, ExternObjDeleter{});
+    ::mlc::base::SizeClassPool::FreeSized(objptr);
   } else {
     MLC_THROW(InternalError) << "Cannot find type info for type index: " << type_index;
   }
@@ -140,12 +141,25 @@ inline ::mlc::Str Lib::Str(AnyView obj) {
   ::mlc::base::FuncCall(func, 1, &obj, &ret);
   return ret;
 }
+inline ::mlc::Str Lib::StrIntern(AnyView source) {
+  static FuncObj *func_str_intern = ::mlc::Lib::FuncGetGlobal("mlc.core.StrIntern");
+  Any ret;
+  ::mlc::base::FuncCall(func_str_intern, 1, &source, &ret);
+  return ret;
+}
 inline Any Lib::IRPrint(AnyView obj, AnyView printer, AnyView path) {
   FuncObj *func = Lib::VTableGetFunc(ir_print, obj.GetTypeIndex(), "__ir_print__");
   Any ret;
   ::mlc::base::FuncCall(func, 3, std::array<AnyView, 3>{obj, printer, path}.data(), &ret);
   return ret;
 }
+inline Any Lib::Rewrite(AnyView root, FuncObj *fn) {
+  static FuncObj *func_rewrite = ::mlc::Lib::FuncGetGlobal("mlc.core.Rewrite");
+  AnyView args[2]{root, fn};
+  Any ret;
+  ::mlc::base::FuncCall(func_rewrite, 2, args, &ret);
+  return ret;
+}
 inline int32_t Lib::FuncSetGlobal(const char *name, FuncObj *func, bool allow_override) {
   MLC_CHECK_ERR(::MLCFuncSetGlobal(_lib, name, Any(func), allow_override));
   return 0;
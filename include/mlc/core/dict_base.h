@@ -3,6 +3,13 @@
 #include <iterator>
 #include <mlc/base/all.h>
 #include <type_traits>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MLC_DICT_TAG_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MLC_DICT_TAG_NEON 1
+#endif
 
 namespace mlc {
 namespace core {
@@ -25,6 +32,7 @@ struct DictBase : public MLCDict {
   MLC_INLINE uint64_t Cap() const { return static_cast<uint64_t>(this->MLCDict::capacity); }
   MLC_INLINE uint64_t Size() const { return this->MLCDict::size; }
   MLC_INLINE Block *Blocks() const { return static_cast<Block *>(this->data); }
+  MLC_INLINE static uint32_t MatchTag(const Block *block, uint8_t tag);
   MLC_INLINE void Swap(DictBase *other) {
     MLCDict tmp = *static_cast<MLCDict *>(other);
     *static_cast<MLCDict *>(other) = *static_cast<MLCDict *>(this);
@@ -97,9 +105,15 @@ struct DictBase : public MLCDict {
    *   the "next pointer" (i.e. pointer to the next element),  where `kNextProbeLocation[YYYYYYY]`
    *   is the offset to the next element. And if `YYYYYYY == 0`, it means the end of the linked
    *   list.
+   *
+   * Each occupied slot also carries a 1-byte hash tag, taken from bits of the hash that are not used
+   * to locate the head of the list. Lookups compare tags first, and only call `Equal` on slots whose
+   * tags match. `MatchTag` compares the tags of a whole block at once (SSE2/NEON when available).
+   * Tags of empty and protected slots are meaningless and never read.
    */
   struct Block {
     uint8_t meta[kBlockCapacity];
+    uint8_t tag[kBlockCapacity];
     KVPair data[kBlockCapacity];
   };
 };
@@ -121,8 +135,10 @@ struct DictBase::BlockIter {
     return BlockIter::FromIndex(self,
                                 (11400714819323198485ull * h) >> (::mlc::base::CountLeadingZeros(self->capacity) + 1));
   }
+  MLC_INLINE static uint8_t HashTag(uint64_t h) { return static_cast<uint8_t>((11400714819323198485ull * h) >> 8); }
   MLC_INLINE auto &Data() const { return cur->data[i % DictBase::kBlockCapacity]; }
   MLC_INLINE uint8_t &Meta() const { return cur->meta[i % DictBase::kBlockCapacity]; }
+  MLC_INLINE uint8_t &Tag() const { return cur->tag[i % DictBase::kBlockCapacity]; }
   MLC_INLINE uint64_t Offset() const { return kNextProbeLocation[Meta() & 0b01111111]; }
   MLC_INLINE bool IsHead() const { return (Meta() & 0b10000000) == 0b00000000; }
   MLC_INLINE void SetNext(uint8_t jump) const { (Meta() &= 0b10000000) |= jump; }
@@ -155,7 +171,37 @@ inline DictBase::DictBase(int64_t capacity) : MLCDict() {
   Block *blocks = this->Blocks();
   for (int64_t i = 0; i < num_blocks; ++i) {
     std::memset(blocks[i].meta, DictBase::kEmptySlot, sizeof(blocks[i].meta));
+    std::memset(blocks[i].tag, 0, sizeof(blocks[i].tag));
+  }
+}
+
+MLC_INLINE uint32_t DictBase::MatchTag(const Block *block, uint8_t tag) {
+  // Returns a bitmask of slots in `block` that are occupied and whose tag equals `tag`.
+  // A slot is occupied iff its metadata is neither `kEmptySlot` nor `kProtectedSlot`.
+  constexpr uint8_t kMaxOccupied = DictBase::kProtectedSlot - 1;
+#if defined(MLC_DICT_TAG_SSE2)
+  __m128i meta = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block->meta));
+  __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block->tag));
+  __m128i occupied = _mm_cmpeq_epi8(_mm_min_epu8(meta, _mm_set1_epi8(static_cast<char>(kMaxOccupied))), meta);
+  __m128i hit = _mm_and_si128(_mm_cmpeq_epi8(tags, _mm_set1_epi8(static_cast<char>(tag))), occupied);
+  return static_cast<uint32_t>(_mm_movemask_epi8(hit));
+#elif defined(MLC_DICT_TAG_NEON)
+  static constexpr uint8_t kBits[kBlockCapacity] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t meta = vld1q_u8(block->meta);
+  uint8x16_t tags = vld1q_u8(block->tag);
+  uint8x16_t hit = vandq_u8(vceqq_u8(tags, vdupq_n_u8(tag)), vcleq_u8(meta, vdupq_n_u8(kMaxOccupied)));
+  uint8x16_t bits = vandq_u8(hit, vld1q_u8(kBits));
+  return static_cast<uint32_t>(vaddv_u8(vget_low_u8(bits))) |
+         (static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8);
+#else
+  uint32_t mask = 0;
+  for (int32_t j = 0; j < DictBase::kBlockCapacity; ++j) {
+    if (block->meta[j] <= kMaxOccupied && block->tag[j] == tag) {
+      mask |= static_cast<uint32_t>(1) << j;
+    }
   }
+  return mask;
+#endif
 }
 
 MLC_INLINE DictBase::BlockIter DictBase::Head(uint64_t hash) const {
@@ -238,7 +284,9 @@ inline DictBase::KVPair *DictBase::Accessor<TDictObj>::TryInsertOrLookup(TDictOb
     return nullptr;
   }
   // `iter` starts from the head of the linked list
-  BlockIter iter = BlockIter::FromHash(self_base, Hash(*key));
+  uint64_t hash = Hash(*key);
+  uint8_t tag = BlockIter::HashTag(hash);
+  BlockIter iter = BlockIter::FromHash(self_base, hash);
   uint8_t new_meta = DictBase::kNewHead;
   // There are three cases over all:
   // 1) available - `iter` points to an empty slot that we could directly write in;
@@ -250,7 +298,7 @@ inline DictBase::KVPair *DictBase::Accessor<TDictObj>::TryInsertOrLookup(TDictOb
   } else if (iter.IsHead()) { // (Case 2) hit
     // Point `iter` to the last element of the linked list
     for (BlockIter prev = iter;; prev = iter) {
-      if (Equal(*key, iter.Data().first)) {
+      if (iter.Tag() == tag && Equal(*key, iter.Data().first)) {
         return &iter.Data();
       }
       iter.Advance(self_base);
@@ -284,6 +332,7 @@ inline DictBase::KVPair *DictBase::Accessor<TDictObj>::TryInsertOrLookup(TDictOb
       // Step 2. Relocate `next` to `new_next`
       new_next.Meta() = DictBase::kNewTail;
       new_next.Data() = {next.Data().first, next.Data().second};
+      new_next.Tag() = next.Tag();
       std::swap(next_meta, next.Meta());
       prev.SetNext(jump);
       // Step 3. Update `prev` -> `new_next`, `next` -> `Advance(next)`
@@ -293,6 +342,7 @@ inline DictBase::KVPair *DictBase::Accessor<TDictObj>::TryInsertOrLookup(TDictOb
   }
   self_base->MLCDict::size += 1;
   iter.Meta() = new_meta;
+  iter.Tag() = tag;
   auto &kv = iter.Data() = {*key, MLCAny()};
   key->type_index = 0;
   key->v.v_int64 = 0;
@@ -326,6 +376,7 @@ inline void DictBase::Accessor<TDictObj>::_Erase(TDictObj *self, int64_t index)
     static_cast<Any &>(kv.first).Reset();
     static_cast<Any &>(kv.second).Reset();
     kv = next.Data();
+    iter.Tag() = next.Tag();
     next.Meta() = DictBase::kEmptySlot;
     prev.SetNext(0);
   } else {
@@ -365,11 +416,26 @@ inline DictBase::BlockIter DictBase::Accessor<TDictObj>::Lookup(const TDictObj *
     return BlockIter::None();
   }
   uint64_t hash = Hash(key);
-  for (BlockIter iter = self_base->Head(hash); !iter.IsNone(); iter.Advance(self_base)) {
+  BlockIter head = self_base->Head(hash);
+  if (head.IsNone()) {
+    return BlockIter::None();
+  }
+  uint8_t tag = BlockIter::HashTag(hash);
+  // Fast path: keys are unique in the dict, so any occupied slot in the head's block whose key
+  // equals `key` is the answer, no matter which linked list it belongs to.
+  uint64_t block_begin = head.i - head.i % DictBase::kBlockCapacity;
+  for (uint32_t mask = DictBase::MatchTag(head.cur, tag); mask != 0; mask &= mask - 1) {
+    BlockIter iter(block_begin + ::mlc::base::CountTrailingZeros(mask), head.cur);
     if (Equal(key, iter.Data().first)) {
       return iter;
     }
   }
+  // Slow path: walk the rest of the linked list, skipping the head's block that is already checked
+  for (BlockIter iter = head; !iter.IsNone(); iter.Advance(self_base)) {
+    if (iter.cur != head.cur && iter.Tag() == tag && Equal(key, iter.Data().first)) {
+      return iter;
+    }
+  }
   return BlockIter::None();
 }
 
@@ -438,7 +504,7 @@ inline typename DictBase::IterState<is_const>::TValuePtr DictBase::IterState<is_
   return reinterpret_cast<TValuePtr>(&ret);
 }
 
-static_assert(sizeof(DictBase::Block) == DictBase::kBlockCapacity * (1 + sizeof(MLCAny) * 2), "ABI check");
+static_assert(sizeof(DictBase::Block) == DictBase::kBlockCapacity * (2 + sizeof(MLCAny) * 2), "ABI check");
 static_assert(std::is_aggregate_v<DictBase::Block>, "ABI check");
 static_assert(std::is_trivially_destructible_v<DictBase::Block>, "ABI check");
 static_assert(std::is_standard_layout_v<DictBase::Block>, "ABI check");
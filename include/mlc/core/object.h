@@ -25,6 +25,8 @@ struct ObjectRefDummyRoot : protected ::mlc::base::PtrBase {
 #define MLC_DEF_TYPE_COMMON_(IS_EXPORT, SelfType, ParentType, TypeIndex, TypeKey)                                      \
 public:                                                                                                                \
   template <typename> friend struct ::mlc::DefaultObjectAllocator;                                                     \
+  template <typename> friend struct ::mlc::PoolObjectAllocator;                                                        \
+  template <typename> friend struct ::mlc::ArenaObjectAllocator;                                                       \
   template <typename> friend struct ::mlc::base::ObjPtrTraitsDefault;                                                  \
   template <typename, typename> friend struct ::mlc::base::TypeTraits;                                                 \
   using TObj = SelfType;                                                                                               \
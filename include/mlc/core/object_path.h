@@ -10,6 +10,7 @@ namespace core {
 struct ObjectPath;
 
 struct ObjectPathObj : public Object {
+  using Allocator = ::mlc::PoolObjectAllocator<ObjectPathObj>;
   /*!
    * kind = -1 ==> {root}
    * kind =  0 ==> field_name (const char *)
@@ -123,7 +124,12 @@ inline bool ObjectPathObj::Equal(const ObjectPathObj *other) const {
       MLC_OBJ_PATH_CHECK_SEG(p->key, q->key, int64_t);
     }
     int32_t type_index = p->key.GetTypeIndex();
-    if (type_index != q->key.GetTypeIndex()) {
+    if (::mlc::base::IsTypeIndexStr(type_index) && ::mlc::base::IsTypeIndexStr(q->key.GetTypeIndex())) {
+      if (!::mlc::base::AnyEqual(p->key, q->key)) {
+        return false;
+      }
+      continue;
+    } else if (type_index != q->key.GetTypeIndex()) {
       return false;
     } else if (type_index >= kMLCStaticObjectBegin) {
       MLC_OBJ_PATH_CHECK_SEG(p->key, q->key, Object *);
@@ -17,6 +17,9 @@ template <> struct TypeTraits<StrObj *> {
     if (v->type_index == static_cast<int32_t>(MLCTypeIndex::kMLCRawStr)) {
       return StrCopyFromCharArray(v->v.v_str, std::strlen(v->v.v_str));
     }
+    if (v->type_index == static_cast<int32_t>(MLCTypeIndex::kMLCSmallStr)) {
+      return StrCopyFromCharArray(v->v.v_bytes, v->small_len);
+    }
     return AnyToTypeUnowned(v);
   }
   MLC_INLINE static T *AnyToTypeWithStorage(const MLCAny *v, Any *storage) {
@@ -25,6 +28,11 @@ template <> struct TypeTraits<StrObj *> {
       *storage = reinterpret_cast<Object *>(ret);
       return ret;
     }
+    if (v->type_index == static_cast<int32_t>(MLCTypeIndex::kMLCSmallStr)) {
+      StrObj *ret = StrCopyFromCharArray(v->v.v_bytes, v->small_len);
+      *storage = reinterpret_cast<Object *>(ret);
+      return ret;
+    }
     return AnyToTypeUnowned(v);
   }
 };
@@ -58,6 +66,7 @@ struct StrObj : public MLCStr {
     if (this->length() > 0) {
       this->back() = '\0';
       this->MLCStr::length -= 1;
+      this->MLCStr::hash = 0;
     }
   }
   MLC_INLINE bool StartsWith(const std::string &prefix) {
@@ -68,7 +77,8 @@ struct StrObj : public MLCStr {
     int64_t N = static_cast<int64_t>(suffix.length());
     return N <= MLCStr::length && strncmp(MLCStr::data + MLCStr::length - N, suffix.data(), N) == 0;
   }
-  MLC_INLINE void PrintEscape(std::ostream &os) const;
+  MLC_INLINE void PrintEscape(std::ostream &os) const { PrintEscape(this->MLCStr::data, this->MLCStr::length, os); }
+  static void PrintEscape(const char *data, int64_t length, std::ostream &os);
   MLC_INLINE int32_t Compare(const char *rhs_str, int64_t rhs_len) const {
     return ::mlc::base::StrCompare(this->MLCStr::data, rhs_str, this->MLCStr::length, rhs_len);
   }
@@ -82,7 +92,7 @@ struct StrObj : public MLCStr {
     return this->Compare(other, static_cast<int64_t>(std::strlen(other)));
   }
   MLC_INLINE uint64_t Hash() const {
-    return ::mlc::base::StrHash(this->MLCStr::data, this->MLCStr::length); //
+    return ::mlc::base::StrHash(static_cast<const MLCStr *>(this)); //
   }
   inline std::vector<std::string_view> Split(char delim) const {
     std::vector<std::string_view> ret;
@@ -115,7 +125,7 @@ struct StrStd : public StrObj {
 };
 
 struct StrPad : public StrObj {
-  using Allocator = ::mlc::DefaultObjectAllocator<StrPad>;
+  using Allocator = ::mlc::PoolObjectAllocator<StrPad>;
 
   MLC_INLINE StrPad(int64_t N) : StrObj() {
     this->MLCStr::length = N;
@@ -163,6 +173,11 @@ struct Str : public ObjectRef {
   template <size_t N>
   MLC_INLINE Str(const ::mlc::base::CharArray<N> &str) : ObjectRef(StrObj::Allocator::New<N>(str)) {}
   MLC_INLINE Str FromEscaped(int64_t N, const char *str);
+  /*!
+   * \brief Returns the canonical string in the global interning table that equals `source`.
+   * Interned strings are never freed, have their hash precomputed, and compare equal by pointer.
+   */
+  MLC_INLINE static Str Intern(AnyView source) { return Lib::StrIntern(source); }
   MLC_INLINE const char *c_str() const { return this->get()->c_str(); }
   MLC_INLINE const char *data() const { return this->get()->data(); }
   MLC_INLINE int64_t length() const { return this->get()->length(); }
@@ -289,9 +304,7 @@ inline std::ostream &operator<<(std::ostream &os, const Object &src) {
   return os;
 }
 
-inline void StrObj::PrintEscape(std::ostream &oss) const {
-  const char *data = this->MLCStr::data;
-  int64_t length = this->MLCStr::length;
+inline void StrObj::PrintEscape(const char *data, int64_t length, std::ostream &oss) {
   oss << '"';
   for (int64_t i = 0; i < length;) {
     unsigned char c = static_cast<unsigned char>(data[i]);
@@ -15,6 +15,143 @@ namespace core {
 
 void ReportTypeFieldError(const char *type_key, MLCTypeField *field);
 
+/*! \brief Decodes how a field is visited, which the type table compiles into per-type visitation plans. */
+inline int32_t FieldVisitOpKind(const MLCTypeField *field) {
+  int32_t num_bytes = field->num_bytes;
+  int32_t ty_index = field->ty->type_index;
+  if (ty_index == kMLCTypingAny && num_bytes == sizeof(MLCAny)) {
+    return kMLCVisitAny;
+  } else if (ty_index == kMLCTypingAtomic) {
+    int32_t type_index = reinterpret_cast<MLCTypingAtomic *>(field->ty)->type_index;
+    if (type_index >= MLCTypeIndex::kMLCStaticObjectBegin && num_bytes == sizeof(MLCObjPtr)) {
+      return kMLCVisitObjectRef;
+    } else if (type_index == kMLCBool && num_bytes == 1) {
+      return kMLCVisitBool;
+    } else if (type_index == kMLCInt && num_bytes == 1) {
+      return kMLCVisitInt8;
+    } else if (type_index == kMLCInt && num_bytes == 2) {
+      return kMLCVisitInt16;
+    } else if (type_index == kMLCInt && num_bytes == 4) {
+      return kMLCVisitInt32;
+    } else if (type_index == kMLCInt && num_bytes == 8) {
+      return kMLCVisitInt64;
+    } else if (type_index == kMLCFloat && num_bytes == 4) {
+      return kMLCVisitFloat32;
+    } else if (type_index == kMLCFloat && num_bytes == 8) {
+      return kMLCVisitFloat64;
+    } else if (type_index == kMLCPtr && num_bytes == sizeof(void *)) {
+      return kMLCVisitPtr;
+    } else if (type_index == kMLCDataType && num_bytes == sizeof(DLDataType)) {
+      return kMLCVisitDataType;
+    } else if (type_index == kMLCDevice && num_bytes == sizeof(DLDevice)) {
+      return kMLCVisitDevice;
+    } else if (type_index == kMLCRawStr) {
+      return kMLCVisitRawStr;
+    }
+  } else if (ty_index == kMLCTypingPtr) { // TODO: support pointer type
+    return kMLCVisitUnsupportedPtr;
+  } else if (ty_index == kMLCTypingOptional && num_bytes == sizeof(MLCObjPtr)) {
+    MLCAny *ty = reinterpret_cast<MLCTypingOptional *>(field->ty)->ty.ptr;
+    if (ty->type_index == kMLCTypingAtomic) {
+      int32_t type_index = reinterpret_cast<MLCTypingAtomic *>(ty)->type_index;
+      if (type_index >= kMLCStaticObjectBegin) {
+        return kMLCVisitOptionalObjectRef;
+      } else if (type_index == kMLCBool) {
+        return kMLCVisitOptionalBool;
+      } else if (type_index == kMLCInt) {
+        return kMLCVisitOptionalInt64;
+      } else if (type_index == kMLCFloat) {
+        return kMLCVisitOptionalFloat64;
+      } else if (type_index == kMLCPtr) {
+        return kMLCVisitOptionalPtr;
+      } else if (type_index == kMLCDataType) {
+        return kMLCVisitOptionalDataType;
+      } else if (type_index == kMLCDevice) {
+        return kMLCVisitOptionalDevice;
+      }
+    } else if (ty->type_index == kMLCTypingList || ty->type_index == kMLCTypingDict) {
+      return kMLCVisitOptionalObjectRef;
+    }
+  } else if (ty_index == kMLCTypingList && num_bytes == sizeof(MLCObjPtr)) {
+    return kMLCVisitObjectRef;
+  } else if (ty_index == kMLCTypingDict && num_bytes == sizeof(MLCObjPtr)) {
+    return kMLCVisitObjectRef;
+  }
+  return kMLCVisitUnsupported;
+}
+
+template <typename Visitor, typename... Args>
+MLC_INLINE void VisitOp(Object *root, const MLCTypeInfo *info, const MLCVisitOp *op, Visitor &visitor, Args... args) {
+  MLCTypeField *field = op->field;
+  void *field_addr = reinterpret_cast<char *>(root) + op->offset;
+  switch (op->kind) {
+  case kMLCVisitAny:
+    visitor(field, args..., static_cast<Any *>(field_addr));
+    break;
+  case kMLCVisitObjectRef:
+    visitor(field, args..., static_cast<ObjectRef *>(field_addr));
+    break;
+  case kMLCVisitOptionalObjectRef:
+    visitor(field, args..., static_cast<Optional<ObjectRef> *>(field_addr));
+    break;
+  case kMLCVisitBool:
+    visitor(field, args..., static_cast<bool *>(field_addr));
+    break;
+  case kMLCVisitInt8:
+    visitor(field, args..., static_cast<int8_t *>(field_addr));
+    break;
+  case kMLCVisitInt16:
+    visitor(field, args..., static_cast<int16_t *>(field_addr));
+    break;
+  case kMLCVisitInt32:
+    visitor(field, args..., static_cast<int32_t *>(field_addr));
+    break;
+  case kMLCVisitInt64:
+    visitor(field, args..., static_cast<int64_t *>(field_addr));
+    break;
+  case kMLCVisitFloat32:
+    visitor(field, args..., static_cast<float *>(field_addr));
+    break;
+  case kMLCVisitFloat64:
+    visitor(field, args..., static_cast<double *>(field_addr));
+    break;
+  case kMLCVisitPtr:
+    visitor(field, args..., static_cast<void **>(field_addr));
+    break;
+  case kMLCVisitDataType:
+    visitor(field, args..., static_cast<DLDataType *>(field_addr));
+    break;
+  case kMLCVisitDevice:
+    visitor(field, args..., static_cast<DLDevice *>(field_addr));
+    break;
+  case kMLCVisitRawStr:
+    visitor(field, args..., static_cast<const char **>(field_addr));
+    break;
+  case kMLCVisitOptionalBool:
+    visitor(field, args..., static_cast<Optional<bool> *>(field_addr));
+    break;
+  case kMLCVisitOptionalInt64:
+    visitor(field, args..., static_cast<Optional<int64_t> *>(field_addr));
+    break;
+  case kMLCVisitOptionalFloat64:
+    visitor(field, args..., static_cast<Optional<double> *>(field_addr));
+    break;
+  case kMLCVisitOptionalPtr:
+    visitor(field, args..., static_cast<Optional<void *> *>(field_addr));
+    break;
+  case kMLCVisitOptionalDataType:
+    visitor(field, args..., static_cast<Optional<DLDataType> *>(field_addr));
+    break;
+  case kMLCVisitOptionalDevice:
+    visitor(field, args..., static_cast<Optional<DLDevice> *>(field_addr));
+    break;
+  case kMLCVisitUnsupportedPtr:
+    MLC_THROW(InternalError) << "Pointer type is not supported yet";
+  default:
+    ReportTypeFieldError(info->type_key, field);
+  }
+}
+
 template <typename Visitor> inline void VisitFields(Object *root, MLCTypeInfo *info, Visitor &&visitor) {
   if (root == nullptr) {
     MLC_THROW(ValueError) << "Root is nullptr";
@@ -22,76 +159,27 @@ template <typename Visitor> inline void VisitFields(Object *root, MLCTypeInfo *i
   if (info == nullptr) {
     info = Lib::GetTypeInfo(root->GetTypeIndex());
   }
-  MLCTypeField *fields = info->fields;
-  MLCTypeField *field = fields;
-  for (; field->name != nullptr; ++field) {
-    void *field_addr = reinterpret_cast<char *>(root) + field->offset;
-    int32_t num_bytes = field->num_bytes;
-    if (field->ty->type_index == kMLCTypingAny && num_bytes == sizeof(MLCAny)) {
-      visitor(field, static_cast<Any *>(field_addr));
-    } else if (field->ty->type_index == kMLCTypingAtomic) {
-      int32_t type_index = reinterpret_cast<MLCTypingAtomic *>(field->ty)->type_index;
-      if (type_index >= MLCTypeIndex::kMLCStaticObjectBegin && num_bytes == sizeof(MLCObjPtr)) {
-        visitor(field, static_cast<ObjectRef *>(field_addr));
-      } else if (type_index == kMLCBool && num_bytes == 1) {
-        visitor(field, static_cast<bool *>(field_addr));
-      } else if (type_index == kMLCInt && num_bytes == 1) {
-        visitor(field, static_cast<int8_t *>(field_addr));
-      } else if (type_index == kMLCInt && num_bytes == 2) {
-        visitor(field, static_cast<int16_t *>(field_addr));
-      } else if (type_index == kMLCInt && num_bytes == 4) {
-        visitor(field, static_cast<int32_t *>(field_addr));
-      } else if (type_index == kMLCInt && num_bytes == 8) {
-        visitor(field, static_cast<int64_t *>(field_addr));
-      } else if (type_index == kMLCFloat && num_bytes == 4) {
-        visitor(field, static_cast<float *>(field_addr));
-      } else if (type_index == kMLCFloat && num_bytes == 8) {
-        visitor(field, static_cast<double *>(field_addr));
-      } else if (type_index == kMLCPtr && num_bytes == sizeof(void *)) {
-        visitor(field, static_cast<void **>(field_addr));
-      } else if (type_index == kMLCDataType && num_bytes == sizeof(DLDataType)) {
-        visitor(field, static_cast<DLDataType *>(field_addr));
-      } else if (type_index == kMLCDevice && num_bytes == sizeof(DLDevice)) {
-        visitor(field, static_cast<DLDevice *>(field_addr));
-      } else if (type_index == kMLCRawStr) {
-        visitor(field, static_cast<const char **>(field_addr));
-      } else {
-        ReportTypeFieldError(info->type_key, field);
-      }
-    } else if (field->ty->type_index == kMLCTypingPtr) { // TODO: support pointer type
-      MLC_THROW(InternalError) << "Pointer type is not supported yet";
-    } else if (field->ty->type_index == kMLCTypingOptional && num_bytes == sizeof(MLCObjPtr)) {
-      MLCAny *ty = reinterpret_cast<MLCTypingOptional *>(field->ty)->ty.ptr;
-      MLCTypingAtomic *ty_atomic = reinterpret_cast<MLCTypingAtomic *>(ty);
-      if (ty->type_index == kMLCTypingAtomic) {
-        if (ty_atomic->type_index >= kMLCStaticObjectBegin) {
-          visitor(field, static_cast<Optional<ObjectRef> *>(field_addr));
-        } else if (ty_atomic->type_index == kMLCBool) {
-          visitor(field, static_cast<Optional<bool> *>(field_addr));
-        } else if (ty_atomic->type_index == kMLCInt) {
-          visitor(field, static_cast<Optional<int64_t> *>(field_addr));
-        } else if (ty_atomic->type_index == kMLCFloat) {
-          visitor(field, static_cast<Optional<double> *>(field_addr));
-        } else if (ty_atomic->type_index == kMLCPtr) {
-          visitor(field, static_cast<Optional<void *> *>(field_addr));
-        } else if (ty_atomic->type_index == kMLCDataType) {
-          visitor(field, static_cast<Optional<DLDataType> *>(field_addr));
-        } else if (ty_atomic->type_index == kMLCDevice) {
-          visitor(field, static_cast<Optional<DLDevice> *>(field_addr));
-        } else {
-          ReportTypeFieldError(info->type_key, field);
-        }
-      } else if (ty->type_index == kMLCTypingList || ty->type_index == kMLCTypingDict) {
-        visitor(field, static_cast<Optional<ObjectRef> *>(field_addr));
-      } else {
-        ReportTypeFieldError(info->type_key, field);
-      }
-    } else if (field->ty->type_index == kMLCTypingList && num_bytes == sizeof(MLCObjPtr)) {
-      visitor(field, static_cast<::mlc::ObjectRef *>(field_addr));
-    } else if (field->ty->type_index == kMLCTypingDict && num_bytes == sizeof(MLCObjPtr)) {
-      visitor(field, static_cast<::mlc::ObjectRef *>(field_addr));
-    } else {
-      ReportTypeFieldError(info->type_key, field);
+  if (const MLCVisitOp *op = info->field_plan) {
+    for (; op->kind != kMLCVisitEnd; ++op) {
+      VisitOp(root, info, op, visitor);
+    }
+  }
+}
+
+/*!
+ * \brief Visits only the fields that own a reference, i.e. `Any`, `ObjectRef` and `Optional<T>`, so that
+ * plain-old-data fields cost nothing to skip.
+ */
+template <typename Visitor> inline void VisitFieldRefs(Object *root, MLCTypeInfo *info, Visitor &&visitor) {
+  if (root == nullptr) {
+    MLC_THROW(ValueError) << "Root is nullptr";
+  }
+  if (info == nullptr) {
+    info = Lib::GetTypeInfo(root->GetTypeIndex());
+  }
+  if (const MLCVisitOp *op = info->ref_plan) {
+    for (; op->kind != kMLCVisitEnd; ++op) {
+      VisitOp(root, info, op, visitor);
     }
   }
 }
@@ -106,80 +194,9 @@ template <typename Visitor> inline void VisitStructure(Object *root, MLCTypeInfo
   if (info->structure_kind == 0) {
     MLC_THROW(TypeError) << "Structure is not defined for type: " << info->type_key;
   }
-  if (info->sub_structure_indices == nullptr) {
-    return;
-  }
-  for (int32_t i_structure = 0; info->sub_structure_indices[i_structure] != -1; ++i_structure) {
-    int32_t field_index = info->sub_structure_indices[i_structure];
-    StructureFieldKind field_kind = static_cast<StructureFieldKind>(info->sub_structure_kinds[i_structure]);
-    MLCTypeField *field = &info->fields[field_index];
-    void *field_addr = reinterpret_cast<char *>(root) + field->offset;
-    int32_t num_bytes = field->num_bytes;
-    if (field->ty->type_index == kMLCTypingAny && num_bytes == sizeof(MLCAny)) {
-      visitor(field, field_kind, static_cast<Any *>(field_addr));
-    } else if (field->ty->type_index == kMLCTypingAtomic) {
-      int32_t type_index = reinterpret_cast<MLCTypingAtomic *>(field->ty)->type_index;
-      if (type_index >= MLCTypeIndex::kMLCStaticObjectBegin && num_bytes == sizeof(MLCObjPtr)) {
-        visitor(field, field_kind, static_cast<ObjectRef *>(field_addr));
-      } else if (type_index == kMLCBool && num_bytes == 1) {
-        visitor(field, field_kind, static_cast<bool *>(field_addr));
-      } else if (type_index == kMLCInt && num_bytes == 1) {
-        visitor(field, field_kind, static_cast<int8_t *>(field_addr));
-      } else if (type_index == kMLCInt && num_bytes == 2) {
-        visitor(field, field_kind, static_cast<int16_t *>(field_addr));
-      } else if (type_index == kMLCInt && num_bytes == 4) {
-        visitor(field, field_kind, static_cast<int32_t *>(field_addr));
-      } else if (type_index == kMLCInt && num_bytes == 8) {
-        visitor(field, field_kind, static_cast<int64_t *>(field_addr));
-      } else if (type_index == kMLCFloat && num_bytes == 4) {
-        visitor(field, field_kind, static_cast<float *>(field_addr));
-      } else if (type_index == kMLCFloat && num_bytes == 8) {
-        visitor(field, field_kind, static_cast<double *>(field_addr));
-      } else if (type_index == kMLCPtr && num_bytes == sizeof(void *)) {
-        visitor(field, field_kind, static_cast<void **>(field_addr));
-      } else if (type_index == kMLCDataType && num_bytes == sizeof(DLDataType)) {
-        visitor(field, field_kind, static_cast<DLDataType *>(field_addr));
-      } else if (type_index == kMLCDevice && num_bytes == sizeof(DLDevice)) {
-        visitor(field, field_kind, static_cast<DLDevice *>(field_addr));
-      } else if (type_index == kMLCRawStr) {
-        visitor(field, field_kind, static_cast<const char **>(field_addr));
-      } else {
-        ReportTypeFieldError(info->type_key, field);
-      }
-    } else if (field->ty->type_index == kMLCTypingPtr) { // TODO: support pointer type
-      MLC_THROW(InternalError) << "Pointer type is not supported yet";
-    } else if (field->ty->type_index == kMLCTypingOptional && num_bytes == sizeof(MLCObjPtr)) {
-      MLCAny *ty = reinterpret_cast<MLCTypingOptional *>(field->ty)->ty.ptr;
-      MLCTypingAtomic *ty_atomic = reinterpret_cast<MLCTypingAtomic *>(ty);
-      if (ty->type_index == kMLCTypingAtomic) {
-        if (ty_atomic->type_index >= kMLCStaticObjectBegin) {
-          visitor(field, field_kind, static_cast<Optional<ObjectRef> *>(field_addr));
-        } else if (ty_atomic->type_index == kMLCBool) {
-          visitor(field, field_kind, static_cast<Optional<bool> *>(field_addr));
-        } else if (ty_atomic->type_index == kMLCInt) {
-          visitor(field, field_kind, static_cast<Optional<int64_t> *>(field_addr));
-        } else if (ty_atomic->type_index == kMLCFloat) {
-          visitor(field, field_kind, static_cast<Optional<double> *>(field_addr));
-        } else if (ty_atomic->type_index == kMLCPtr) {
-          visitor(field, field_kind, static_cast<Optional<void *> *>(field_addr));
-        } else if (ty_atomic->type_index == kMLCDataType) {
-          visitor(field, field_kind, static_cast<Optional<DLDataType> *>(field_addr));
-        } else if (ty_atomic->type_index == kMLCDevice) {
-          visitor(field, field_kind, static_cast<Optional<DLDevice> *>(field_addr));
-        } else {
-          ReportTypeFieldError(info->type_key, field);
-        }
-      } else if (ty->type_index == kMLCTypingList || ty->type_index == kMLCTypingDict) {
-        visitor(field, field_kind, static_cast<Optional<ObjectRef> *>(field_addr));
-      } else {
-        ReportTypeFieldError(info->type_key, field);
-      }
-    } else if (field->ty->type_index == kMLCTypingList && num_bytes == sizeof(MLCObjPtr)) {
-      visitor(field, field_kind, static_cast<::mlc::ObjectRef *>(field_addr));
-    } else if (field->ty->type_index == kMLCTypingDict && num_bytes == sizeof(MLCObjPtr)) {
-      visitor(field, field_kind, static_cast<::mlc::ObjectRef *>(field_addr));
-    } else {
-      ReportTypeFieldError(info->type_key, field);
+  if (const MLCVisitOp *op = info->structure_plan) {
+    for (; op->kind != kMLCVisitEnd; ++op) {
+      VisitOp(root, info, op, visitor, static_cast<StructureFieldKind>(op->field_kind));
     }
   }
 }
@@ -278,7 +295,7 @@ inline void TopoVisit(Object *root, std::function<void(Object *object, MLCTypeIn
           type_index == kMLCTensor) {
         continue;
       } else {
-        VisitFields(current->obj, current->type_info, FieldExtractor{&state, current});
+        VisitFieldRefs(current->obj, current->type_info, FieldExtractor{&state, current});
       }
     }
   }
@@ -42,6 +42,7 @@ namespace printer {
 struct NodeObj : public ::mlc::Object {
   ::mlc::List<::mlc::core::ObjectPath> source_paths;
   explicit NodeObj(::mlc::List<::mlc::core::ObjectPath> source_paths) : source_paths(source_paths) {}
+  using Allocator = ::mlc::PoolObjectAllocator<NodeObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, NodeObj, ::mlc::Object, "mlc.printer.ast.Node");
   mlc::Str ToPython(PrinterConfig cfg) const {
     static auto func = ::mlc::base::GetGlobalFuncCall<2>("mlc.printer.DocToPythonScript");
@@ -75,6 +76,7 @@ struct ExprObj : public ::mlc::Object {
   Expr CallKw(mlc::List<::mlc::printer::Expr> args, mlc::List<::mlc::Str> kwargs_keys,
               mlc::List<::mlc::printer::Expr> kwargs_values) const;
 
+  using Allocator = ::mlc::PoolObjectAllocator<ExprObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, ExprObj, ::mlc::printer::NodeObj, "mlc.printer.ast.Expr");
 }; // struct ExprObj
 
@@ -100,6 +102,7 @@ struct StmtObj : public ::mlc::Object {
   ::mlc::Optional<::mlc::Str> comment;
   explicit StmtObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::Optional<::mlc::Str> comment)
       : source_paths(source_paths), comment(comment) {}
+  using Allocator = ::mlc::PoolObjectAllocator<StmtObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, StmtObj, ::mlc::printer::NodeObj, "mlc.printer.ast.Stmt");
 }; // struct StmtObj
 
@@ -124,6 +127,7 @@ struct StmtBlockObj : public ::mlc::Object {
   explicit StmtBlockObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::Optional<::mlc::Str> comment,
                         ::mlc::List<::mlc::printer::Stmt> stmts)
       : source_paths(source_paths), comment(comment), stmts(stmts) {}
+  using Allocator = ::mlc::PoolObjectAllocator<StmtBlockObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, StmtBlockObj, ::mlc::printer::StmtObj, "mlc.printer.ast.StmtBlock");
 }; // struct StmtBlockObj
 
@@ -148,6 +152,7 @@ struct LiteralObj : public ::mlc::Object {
   ::mlc::Any value;
   explicit LiteralObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::Any value)
       : source_paths(source_paths), value(value) {}
+  using Allocator = ::mlc::PoolObjectAllocator<LiteralObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, LiteralObj, ::mlc::printer::ExprObj, "mlc.printer.ast.Literal");
 }; // struct LiteralObj
 
@@ -177,6 +182,7 @@ struct IdObj : public ::mlc::Object {
   explicit IdObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::Str name)
       : source_paths(source_paths), name(name) {}
   explicit IdObj(::mlc::Str name) : source_paths(), name(name) {}
+  using Allocator = ::mlc::PoolObjectAllocator<IdObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, IdObj, ::mlc::printer::ExprObj, "mlc.printer.ast.Id");
 }; // struct IdObj
 
@@ -200,6 +206,7 @@ struct AttrObj : public ::mlc::Object {
   ::mlc::Str name;
   explicit AttrObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::printer::Expr obj, ::mlc::Str name)
       : source_paths(source_paths), obj(obj), name(name) {}
+  using Allocator = ::mlc::PoolObjectAllocator<AttrObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, AttrObj, ::mlc::printer::ExprObj, "mlc.printer.ast.Attr");
 }; // struct AttrObj
 
@@ -226,6 +233,7 @@ struct IndexObj : public ::mlc::Object {
   explicit IndexObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::printer::Expr obj,
                     ::mlc::List<::mlc::printer::Expr> idx)
       : source_paths(source_paths), obj(obj), idx(idx) {}
+  using Allocator = ::mlc::PoolObjectAllocator<IndexObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, IndexObj, ::mlc::printer::ExprObj, "mlc.printer.ast.Index");
 }; // struct IndexObj
 
@@ -256,6 +264,7 @@ struct CallObj : public ::mlc::Object {
                    ::mlc::List<::mlc::printer::Expr> kwargs_values)
       : source_paths(source_paths), callee(callee), args(args), kwargs_keys(kwargs_keys), kwargs_values(kwargs_values) {
   }
+  using Allocator = ::mlc::PoolObjectAllocator<CallObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, CallObj, ::mlc::printer::ExprObj, "mlc.printer.ast.Call");
 }; // struct CallObj
 
@@ -322,6 +331,7 @@ struct OperationObj : public ::mlc::Object {
   explicit OperationObj(::mlc::List<::mlc::core::ObjectPath> source_paths, int64_t op,
                         ::mlc::List<::mlc::printer::Expr> operands)
       : source_paths(source_paths), op(op), operands(operands) {}
+  using Allocator = ::mlc::PoolObjectAllocator<OperationObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, OperationObj, ::mlc::printer::ExprObj, "mlc.printer.ast.Operation");
 }; // struct OperationObj
 
@@ -348,6 +358,7 @@ struct LambdaObj : public ::mlc::Object {
   explicit LambdaObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::List<::mlc::printer::Id> args,
                      ::mlc::printer::Expr body)
       : source_paths(source_paths), args(args), body(body) {}
+  using Allocator = ::mlc::PoolObjectAllocator<LambdaObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, LambdaObj, ::mlc::printer::ExprObj, "mlc.printer.ast.Lambda");
 }; // struct LambdaObj
 
@@ -372,6 +383,7 @@ struct TupleObj : public ::mlc::Object {
   ::mlc::List<::mlc::printer::Expr> values;
   explicit TupleObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::List<::mlc::printer::Expr> values)
       : source_paths(source_paths), values(values) {}
+  using Allocator = ::mlc::PoolObjectAllocator<TupleObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, TupleObj, ::mlc::printer::ExprObj, "mlc.printer.ast.Tuple");
 }; // struct TupleObj
 
@@ -395,6 +407,7 @@ struct ListObj : public ::mlc::Object {
   ::mlc::List<::mlc::printer::Expr> values;
   explicit ListObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::List<::mlc::printer::Expr> values)
       : source_paths(source_paths), values(values) {}
+  using Allocator = ::mlc::PoolObjectAllocator<ListObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, ListObj, ::mlc::printer::ExprObj, "mlc.printer.ast.List");
 }; // struct ListObj
 
@@ -420,6 +433,7 @@ struct DictObj : public ::mlc::Object {
   explicit DictObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::List<::mlc::printer::Expr> keys,
                    ::mlc::List<::mlc::printer::Expr> values)
       : source_paths(source_paths), keys(keys), values(values) {}
+  using Allocator = ::mlc::PoolObjectAllocator<DictObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, DictObj, ::mlc::printer::ExprObj, "mlc.printer.ast.Dict");
 }; // struct DictObj
 
@@ -447,6 +461,7 @@ struct SliceObj : public ::mlc::Object {
   explicit SliceObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::Optional<::mlc::printer::Expr> start,
                     ::mlc::Optional<::mlc::printer::Expr> stop, ::mlc::Optional<::mlc::printer::Expr> step)
       : source_paths(source_paths), start(start), stop(stop), step(step) {}
+  using Allocator = ::mlc::PoolObjectAllocator<SliceObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, SliceObj, ::mlc::printer::ExprObj, "mlc.printer.ast.Slice");
 }; // struct SliceObj
 
@@ -478,6 +493,7 @@ struct AssignObj : public ::mlc::Object {
                      ::mlc::printer::Expr lhs, ::mlc::Optional<::mlc::printer::Expr> rhs,
                      ::mlc::Optional<::mlc::printer::Expr> annotation)
       : source_paths(source_paths), comment(comment), lhs(lhs), rhs(rhs), annotation(annotation) {}
+  using Allocator = ::mlc::PoolObjectAllocator<AssignObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, AssignObj, ::mlc::printer::StmtObj, "mlc.printer.ast.Assign");
 }; // struct AssignObj
 
@@ -510,6 +526,7 @@ struct IfObj : public ::mlc::Object {
                  ::mlc::printer::Expr cond, ::mlc::List<::mlc::printer::Stmt> then_branch,
                  ::mlc::List<::mlc::printer::Stmt> else_branch)
       : source_paths(source_paths), comment(comment), cond(cond), then_branch(then_branch), else_branch(else_branch) {}
+  using Allocator = ::mlc::PoolObjectAllocator<IfObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, IfObj, ::mlc::printer::StmtObj, "mlc.printer.ast.If");
 }; // struct IfObj
 
@@ -541,6 +558,7 @@ struct WhileObj : public ::mlc::Object {
   explicit WhileObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::Optional<::mlc::Str> comment,
                     ::mlc::printer::Expr cond, ::mlc::List<::mlc::printer::Stmt> body)
       : source_paths(source_paths), comment(comment), cond(cond), body(body) {}
+  using Allocator = ::mlc::PoolObjectAllocator<WhileObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, WhileObj, ::mlc::printer::StmtObj, "mlc.printer.ast.While");
 }; // struct WhileObj
 
@@ -570,6 +588,7 @@ struct ForObj : public ::mlc::Object {
   explicit ForObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::Optional<::mlc::Str> comment,
                   ::mlc::printer::Expr lhs, ::mlc::printer::Expr rhs, ::mlc::List<::mlc::printer::Stmt> body)
       : source_paths(source_paths), comment(comment), lhs(lhs), rhs(rhs), body(body) {}
+  using Allocator = ::mlc::PoolObjectAllocator<ForObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, ForObj, ::mlc::printer::StmtObj, "mlc.printer.ast.For");
 }; // struct ForObj
 
@@ -602,6 +621,7 @@ struct WithObj : public ::mlc::Object {
                    ::mlc::Optional<::mlc::printer::Expr> lhs, ::mlc::printer::Expr rhs,
                    ::mlc::List<::mlc::printer::Stmt> body)
       : source_paths(source_paths), comment(comment), lhs(lhs), rhs(rhs), body(body) {}
+  using Allocator = ::mlc::PoolObjectAllocator<WithObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, WithObj, ::mlc::printer::StmtObj, "mlc.printer.ast.With");
 }; // struct WithObj
 
@@ -631,6 +651,7 @@ struct ExprStmtObj : public ::mlc::Object {
   explicit ExprStmtObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::Optional<::mlc::Str> comment,
                        ::mlc::printer::Expr expr)
       : source_paths(source_paths), comment(comment), expr(expr) {}
+  using Allocator = ::mlc::PoolObjectAllocator<ExprStmtObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, ExprStmtObj, ::mlc::printer::StmtObj, "mlc.printer.ast.ExprStmt");
 }; // struct ExprStmtObj
 
@@ -658,6 +679,7 @@ struct AssertObj : public ::mlc::Object {
   explicit AssertObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::Optional<::mlc::Str> comment,
                      ::mlc::printer::Expr cond, ::mlc::Optional<::mlc::printer::Expr> msg)
       : source_paths(source_paths), comment(comment), cond(cond), msg(msg) {}
+  using Allocator = ::mlc::PoolObjectAllocator<AssertObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, AssertObj, ::mlc::printer::StmtObj, "mlc.printer.ast.Assert");
 }; // struct AssertObj
 
@@ -685,6 +707,7 @@ struct ReturnObj : public ::mlc::Object {
   explicit ReturnObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::Optional<::mlc::Str> comment,
                      ::mlc::Optional<::mlc::printer::Expr> value)
       : source_paths(source_paths), comment(comment), value(value) {}
+  using Allocator = ::mlc::PoolObjectAllocator<ReturnObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, ReturnObj, ::mlc::printer::StmtObj, "mlc.printer.ast.Return");
 }; // struct ReturnObj
 
@@ -724,6 +747,7 @@ struct FunctionObj : public ::mlc::Object {
       }
     }
   }
+  using Allocator = ::mlc::PoolObjectAllocator<FunctionObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, FunctionObj, ::mlc::printer::StmtObj, "mlc.printer.ast.Function");
 }; // struct FunctionObj
 
@@ -760,6 +784,7 @@ struct ClassObj : public ::mlc::Object {
                     ::mlc::printer::Id name, ::mlc::List<::mlc::printer::Expr> decorators,
                     ::mlc::List<::mlc::printer::Stmt> body)
       : source_paths(source_paths), comment(comment), name(name), decorators(decorators), body(body) {}
+  using Allocator = ::mlc::PoolObjectAllocator<ClassObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, ClassObj, ::mlc::printer::StmtObj, "mlc.printer.ast.Class");
 }; // struct ClassObj
 
@@ -788,6 +813,7 @@ struct CommentObj : public ::mlc::Object {
   ::mlc::Optional<::mlc::Str> comment;
   explicit CommentObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::Optional<::mlc::Str> comment)
       : source_paths(source_paths), comment(comment) {}
+  using Allocator = ::mlc::PoolObjectAllocator<CommentObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, CommentObj, ::mlc::printer::StmtObj, "mlc.printer.ast.Comment");
 }; // struct CommentObj
 
@@ -811,6 +837,7 @@ struct DocStringObj : public ::mlc::Object {
   ::mlc::Optional<::mlc::Str> comment;
   explicit DocStringObj(::mlc::List<::mlc::core::ObjectPath> source_paths, ::mlc::Optional<::mlc::Str> comment)
       : source_paths(source_paths), comment(comment) {}
+  using Allocator = ::mlc::PoolObjectAllocator<DocStringObj>;
   MLC_DEF_DYN_TYPE(MLC_EXPORTS, DocStringObj, ::mlc::printer::StmtObj, "mlc.printer.ast.DocString");
 }; // struct DocStringObj
 
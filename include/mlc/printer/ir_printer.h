@@ -122,7 +122,7 @@ struct IRPrinterObj : public Object {
     if (source.type_index == kMLCInt) {
       return Literal::Int(source.operator int64_t(), {path});
     }
-    if (source.type_index == kMLCStr || source.type_index == kMLCRawStr) {
+    if (::mlc::base::IsTypeIndexStr(source.type_index) || source.type_index == kMLCRawStr) {
       return Literal::Str(source.operator Str(), {path});
     }
     if (source.type_index == kMLCFloat) {
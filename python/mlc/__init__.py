@@ -1,18 +1,30 @@
 from . import _cython, cc, dataclasses, parser, printer
 from ._cython import Ptr, Str
 from .core import (
+    Arena,
     DataType,
     Device,
     Dict,
     Error,
     Func,
+    HashCons,
+    LazyObject,
     List,
+    MappedBinary,
     Object,
     ObjectPath,
     Opaque,
+    StructuralHashMemo,
     Tensor,
     build_info,
+    dump,
+    eq_s_many,
+    hash_s_many,
     json_loads,
+    load,
+    reclaim_in_background,
+    rewrite,
+    str_intern,
     typing,
 )
 from .dataclasses import PyClass, c_class, py_class
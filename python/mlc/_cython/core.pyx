@@ -66,6 +66,7 @@ cdef extern from "mlc/c_api.h" nogil:
         kMLCDataType = 5
         kMLCDevice = 6
         kMLCRawStr = 7
+        kMLCSmallStr = 8
         kMLCStaticObjectBegin = 1000
         # kMLCCore [1000: 1100) {
         kMLCCoreBegin = 1000
@@ -132,6 +133,7 @@ cdef extern from "mlc/c_api.h" nogil:
         MLCAny _mlc_header
         int64_t length
         char *data
+        uint64_t hash
 
     ctypedef struct MLCFunc:
         MLCAny _mlc_header
@@ -370,6 +372,26 @@ cdef class PyAny:
     def _mlc_from_json(mlc_json):
         return func_call(_DESERIALIZE, (mlc_json,))
 
+    def _mlc_to_bytes(self) -> bytes:
+        cdef MLCAny c_ret = _MLCAnyNone()
+        cdef MLCStr* mlc_str = NULL
+        _func_call_impl(<MLCFunc*>(_BINARY_SERIALIZE._mlc_any.v.v_obj), (self,), &c_ret)
+        try:
+            mlc_str = <MLCStr*>(c_ret.v.v_obj)
+            return mlc_str.data[:mlc_str.length]
+        finally:
+            _check_error(_C_AnyDecRef(&c_ret))
+
+    @staticmethod
+    def _mlc_from_bytes(bytes data):
+        cdef const char* c_data = data
+        cdef MLCAny c_args[2]
+        cdef MLCAny c_ret = _MLCAnyNone()
+        c_args[0] = _MLCAnyPtr(<uint64_t>(c_data))
+        c_args[1] = _MLCAnyInt(len(data))
+        _func_call_impl_with_c_args(<MLCFunc*>(_BINARY_DESERIALIZE_BYTES._mlc_any.v.v_obj), 2, c_args, &c_ret)
+        return _any_c2py_no_inc_ref(c_ret)
+
     @staticmethod
     def _mlc_eq_s(PyAny lhs, PyAny rhs, bint bind_free_vars, bint assert_mode) -> bool:
         return bool(func_call(_STRUCUTRAL_EQUAL, (lhs, rhs, bind_free_vars, assert_mode)))
@@ -381,6 +403,11 @@ cdef class PyAny:
             ret += 2 ** 63
         return ret
 
+    @staticmethod
+    def _mlc_hash_s128(PyAny x) -> object:
+        cdef object ret = func_call(_STRUCUTRAL_HASH_128, (x,))
+        return (ret[0] % 2 ** 64) | ((ret[1] % 2 ** 64) << 64)
+
     @staticmethod
     def _mlc_copy_shallow(PyAny x) -> PyAny:
         return func_call(_COPY_SHALLOW, (x,))
@@ -544,6 +571,10 @@ cdef inline object _any_c2py_no_inc_ref(const MLCAny x):
         str_ret = Str.__new__(Str, str_c2py(mlc_str.data[:mlc_str.length]))
         str_ret._mlc_any = x
         return str_ret
+    elif type_index == kMLCSmallStr:
+        str_ret = Str.__new__(Str, str_c2py(x.v.v_bytes[:x.small_len]))
+        str_ret._mlc_any = x
+        return str_ret
     elif type_index == kMLCOpaque:
         return <object>((<MLCOpaque*>(x.v.v_obj)).handle)
     elif (type_cls := _list_get(TYPE_INDEX_TO_INFO, type_index)) is not None:
@@ -576,6 +607,10 @@ cdef inline object _any_c2py_inc_ref(MLCAny x):
         str_ret._mlc_any = x
         _check_error(_C_AnyIncRef(&x))
         return str_ret
+    elif type_index == kMLCSmallStr:
+        str_ret = Str.__new__(Str, str_c2py(x.v.v_bytes[:x.small_len]))
+        str_ret._mlc_any = x
+        return str_ret
     elif type_index == kMLCOpaque:
         return <object>((<MLCOpaque*>(x.v.v_obj)).handle)
     elif (type_cls := _list_get(TYPE_INDEX_TO_INFO, type_index)) is not None:
@@ -1668,8 +1703,11 @@ cdef const char* _DLPACK_CAPSULE_NAME_VER_USED = "used_dltensor_versioned"
 cdef list TYPE_INDEX_TO_INFO = [None]  # mapping: (type_index: int) ==> (type_info: base.TypeInfo)
 cdef PyAny _SERIALIZE = func_get_untyped("mlc.core.JSONSerialize")  # Any -> str
 cdef PyAny _DESERIALIZE = func_get_untyped("mlc.core.JSONDeserialize")  # str -> Any
+cdef PyAny _BINARY_SERIALIZE = func_get_untyped("mlc.core.BinarySerialize")  # Any -> bytes
+cdef PyAny _BINARY_DESERIALIZE_BYTES = func_get_untyped("mlc.core.BinaryDeserializeBytes")  # (Ptr, int) -> Any
 cdef PyAny _STRUCUTRAL_EQUAL = func_get_untyped("mlc.core.StructuralEqual")
 cdef PyAny _STRUCUTRAL_HASH = func_get_untyped("mlc.core.StructuralHash")
+cdef PyAny _STRUCUTRAL_HASH_128 = func_get_untyped("mlc.core.StructuralHash128")
 cdef PyAny _COPY_SHALLOW = func_get_untyped("mlc.core.CopyShallow")
 cdef PyAny _COPY_DEEP = func_get_untyped("mlc.core.CopyDeep")
 cdef PyAny _TENSOR_TO_DLPACK = func_get_untyped("mlc.core.TensorToDLPack")
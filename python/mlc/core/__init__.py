@@ -1,10 +1,25 @@
 from . import typing
+from .arena import Arena
 from .device import Device
 from .dict import Dict
 from .dtype import DataType
 from .error import Error
-from .func import Func, build_info, json_loads
+from .func import (
+    Func,
+    build_info,
+    dump,
+    eq_s_many,
+    hash_s_many,
+    json_loads,
+    load,
+    reclaim_in_background,
+    rewrite,
+    str_intern,
+)
+from .hash_cons import HashCons
+from .hash_memo import StructuralHashMemo
 from .list import List
+from .mapped_binary import LazyObject, MappedBinary
 from .object import Object
 from .object_path import ObjectPath
 from .opaque import Opaque
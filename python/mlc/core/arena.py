@@ -0,0 +1,32 @@
+from __future__ import annotations
+
+from typing import Any
+
+from .func import Func
+
+
+class Arena:
+    """Scope in which newly created objects are bump-allocated from a region that is
+    freed all at once, cutting allocation cost for transient object graphs.
+
+    Objects still alive when the scope ends are counted in `num_escaped`. They stay
+    valid and keep the region alive until the last of them is freed.
+    """
+
+    def __init__(self) -> None:
+        self._handle: Any = None
+        self.num_escaped: int = 0
+
+    def __enter__(self) -> Arena:
+        if self._handle is not None:
+            raise ValueError("Arena is already entered")
+        self._handle = _C_ArenaEnter()
+        return self
+
+    def __exit__(self, *args: Any) -> None:
+        handle, self._handle = self._handle, None
+        self.num_escaped = _C_ArenaExit(handle)
+
+
+_C_ArenaEnter = Func.get("mlc.core.ArenaEnter")
+_C_ArenaExit = Func.get("mlc.core.ArenaExit")
@@ -1,9 +1,13 @@
 from __future__ import annotations
 
-from collections.abc import Callable
+import codecs
+import ctypes
+import io
+import os
+from collections.abc import Callable, Sequence
 from typing import Any, TypeVar
 
-from mlc._cython import c_class_core, func_call, func_get, func_init, func_register
+from mlc._cython import Str, c_class_core, func_call, func_get, func_init, func_register
 
 from .object import Object
 
@@ -46,5 +50,120 @@ def build_info() -> dict[str, Any]:
     return _build_info()
 
 
+def str_intern(s: str) -> Str:
+    return _str_intern(s)
+
+
+def hash_s_many(objs: Sequence[Any]) -> list[int]:
+    """Structural hashes of many objects, the same as calling `Object.hash_s` on each of them.
+    The objects are hashed in parallel with the GIL released."""
+    return [h + 2**63 if h < 0 else h for h in _hash_s_many(list(objs))]
+
+
+def eq_s_many(pairs: Sequence[tuple[Any, Any]], *, bind_free_vars: bool = True) -> list[bool]:
+    """Structural equality of many pairs of objects, the same as calling `Object.eq_s` on each pair.
+    The pairs are compared in parallel with the GIL released."""
+    return list(_eq_s_many([list(pair) for pair in pairs], bind_free_vars))
+
+
+def rewrite(root: Any, fn: Callable[[Any], Any]) -> Any:
+    """Rewrites the object graph under `root` bottom-up. `fn` is called once on each object other
+    than strings, after its children, and returns its replacement, or the object itself to keep it.
+    Only ancestors of replaced objects are rebuilt; everything else is shared with `root`."""
+    return _rewrite(root, fn)
+
+
+def dump(obj: Any, fp: Any, *, binary: bool = False, tensor_file: Any = None) -> None:
+    """Serializes `obj` into `fp`, which is a path, or a file object opened for writing, in the
+    JSON format of `Object.json`, or the format of `Object.to_bytes` if `binary` is set. The
+    document is written chunk by chunk, so it is never held in memory as a whole.
+
+    If `tensor_file` is a path, tensors of a JSON document are written into it as raw bytes,
+    aligned for `load` to map them without copying, and the document refers to them by
+    `[offset, nbytes]` instead of carrying them as base64."""
+    if binary and tensor_file is not None:
+        raise ValueError("`tensor_file` is only supported by JSON documents")
+    if isinstance(fp, (str, os.PathLike)):
+        with open(fp, "wb") as f:
+            dump(obj, f, binary=binary, tensor_file=tensor_file)
+    elif binary:
+        _dump_into(fp, binary, lambda sink: _binary_serialize_to(obj, sink))
+    elif tensor_file is None:
+        _dump_into(fp, binary, lambda sink: _json_serialize_to(obj, sink, None))
+    else:
+        with open(tensor_file, "wb") as f:
+            tensor_sink = f.fileno()
+            _dump_into(fp, binary, lambda sink: _json_serialize_to(obj, sink, tensor_sink))
+
+
+def _dump_into(fp: Any, binary: bool, serialize_to: Callable[[Any], None]) -> None:
+    fileno = _fileno(fp)
+    if isinstance(fp, io.TextIOBase):
+        if binary:
+            raise TypeError("Cannot write a binary document into a text file")
+        decoder = codecs.getincrementaldecoder("utf-8")()  # chunks may split a character
+        serialize_to(lambda ptr, size: fp.write(decoder.decode(ctypes.string_at(ptr, size))))
+    elif fileno is not None:
+        fp.flush()
+        serialize_to(fileno)
+    else:
+        serialize_to(lambda ptr, size: fp.write(ctypes.string_at(ptr, size)))
+
+
+def load(fp: Any, *, binary: bool = False, tensor_file: Any = None) -> Any:
+    """Deserializes the document written by `dump` from `fp`, a path, or a file object opened
+    for reading, which is consumed to its end. Binary documents are read a window at a time,
+    except from file objects without a file descriptor.
+
+    `tensor_file` is the path given to `dump`. It is memory-mapped, and the tensors are views
+    into the mapping, which stays alive as long as any of them does."""
+    if isinstance(fp, (str, os.PathLike)):
+        with open(fp, "rb") as f:
+            return load(f, binary=binary, tensor_file=tensor_file)
+    if tensor_file is not None:
+        if binary:
+            raise ValueError("`tensor_file` is only supported by JSON documents")
+        tensor_file = os.fspath(tensor_file)
+    fileno = _fileno(fp)
+    if fileno is not None and not isinstance(fp, io.TextIOBase) and fp.seekable():
+        if binary:
+            ret = _binary_deserialize_from(fileno, fp.tell())
+        else:
+            ret = _json_deserialize_from(fileno, fp.tell(), tensor_file)
+        fp.seek(0, os.SEEK_END)
+        return ret
+    data = fp.read()
+    if binary:
+        return Object.from_bytes(data)
+    if isinstance(data, bytes):
+        data = data.decode("utf-8")
+    if tensor_file is not None:
+        return _json_deserialize_tensor_file(data, tensor_file)
+    return Object.from_json(data)
+
+
+def _fileno(fp: Any) -> int | None:
+    try:
+        return fp.fileno()
+    except (AttributeError, OSError):
+        return None
+
+
+def reclaim_in_background(enabled: bool) -> None:
+    """Hands objects released from now on to a background thread for destruction.
+    Disabling it waits until all pending objects are freed."""
+    _reclaim_in_background(enabled)
+
+
 _json_loads = Func.get("mlc.core.JSONLoads")
 _build_info = Func.get("mlc.core.BuildInfo")
+_str_intern = Func.get("mlc.core.StrIntern")
+_reclaim_in_background = Func.get("mlc.core.ReclaimInBackground")
+_hash_s_many = Func.get("mlc.core.StructuralHashMany")
+_eq_s_many = Func.get("mlc.core.StructuralEqualMany")
+_rewrite = Func.get("mlc.core.Rewrite")
+_json_serialize_to = Func.get("mlc.core.JSONSerializeTo")
+_json_deserialize_from = Func.get("mlc.core.JSONDeserializeFrom")
+_json_deserialize_tensor_file = Func.get("mlc.core.JSONDeserializeTensorFile")
+_binary_serialize_to = Func.get("mlc.core.BinarySerializeTo")
+_binary_deserialize_from = Func.get("mlc.core.BinaryDeserializeFrom")
@@ -0,0 +1,43 @@
+from __future__ import annotations
+
+from typing import Any
+
+from .func import Func
+
+
+class HashCons:
+    """Table that maps structurally equal objects to a single canonical representative,
+    keyed on the structural hash and confirmed by `eq_s` without binding free variables.
+
+    Objects added to the table must not be mutated afterwards.
+    """
+
+    def __init__(self) -> None:
+        self._handle: Any = _C_HashConsNew()
+
+    def __del__(self) -> None:
+        handle, self._handle = getattr(self, "_handle", None), None
+        if handle is not None:
+            _C_HashConsDelete(handle)
+
+    def __len__(self) -> int:
+        return _C_HashConsSize(self._handle)
+
+    def canonicalize(self, obj: Any) -> Any:
+        """Returns the representative of `obj`, which becomes one if none is structurally equal.
+        Like `eq_s`, tensors are compared by their metadata only.
+        """
+        return _C_HashConsCanonicalize(self._handle, obj)
+
+    def intern(self, obj: Any) -> Any:
+        """Canonicalizes the whole graph bottom-up, rebuilding parents to refer to the
+        canonical children. Objects that hold tensors, functions or opaque values are kept as is.
+        """
+        return _C_HashConsIntern(self._handle, obj)
+
+
+_C_HashConsNew = Func.get("mlc.core.HashConsNew")
+_C_HashConsDelete = Func.get("mlc.core.HashConsDelete")
+_C_HashConsSize = Func.get("mlc.core.HashConsSize")
+_C_HashConsCanonicalize = Func.get("mlc.core.HashConsCanonicalize")
+_C_HashConsIntern = Func.get("mlc.core.HashConsIntern")
@@ -0,0 +1,37 @@
+from __future__ import annotations
+
+from typing import Any
+
+from .func import Func
+
+
+class StructuralHashMemo:
+    """Cache of structural hashes kept across calls to `Object.hash_s(memo=...)`,
+    so that rehashing a graph after a local edit only visits the changed subtrees.
+
+    Only subtrees that contain no variables, lists or dicts, and whose sub-structure
+    fields are all frozen, are cached. The memo keeps them alive until it is freed.
+    """
+
+    def __init__(self) -> None:
+        self._handle: Any = _C_StructuralHashMemoNew()
+
+    def __del__(self) -> None:
+        handle, self._handle = getattr(self, "_handle", None), None
+        if handle is not None:
+            _C_StructuralHashMemoDelete(handle)
+
+    def __len__(self) -> int:
+        return _C_StructuralHashMemoSize(self._handle)
+
+    def hash_s(self, obj: Any) -> int:
+        ret = _C_StructuralHashMemoized(obj, self._handle)
+        if ret < 0:
+            ret += 2**63
+        return ret
+
+
+_C_StructuralHashMemoNew = Func.get("mlc.core.StructuralHashMemoNew")
+_C_StructuralHashMemoDelete = Func.get("mlc.core.StructuralHashMemoDelete")
+_C_StructuralHashMemoSize = Func.get("mlc.core.StructuralHashMemoSize")
+_C_StructuralHashMemoized = Func.get("mlc.core.StructuralHashMemoized")
@@ -0,0 +1,110 @@
+from __future__ import annotations
+
+import os
+from collections.abc import Iterator
+from typing import Any
+
+from mlc._cython import type_key2py_type_info
+
+from .func import Func
+
+
+class MappedBinary:
+    """A document written by `Object.to_bytes` or `dump(..., binary=True)`, memory-mapped and
+    indexed instead of loaded. Values are only constructed when they are requested, together with
+    the values they refer to, and tensors are views into the mapping rather than copies.
+
+    Constructed values are cached, so that values shared in the document stay shared.
+    """
+
+    def __init__(self, path: str | os.PathLike) -> None:
+        self._handle: Any = _C_MappedBinaryOpen(os.fspath(path))
+
+    def __del__(self) -> None:
+        handle, self._handle = getattr(self, "_handle", None), None
+        if handle is not None:
+            _C_MappedBinaryDelete(handle)
+
+    def __len__(self) -> int:
+        return _C_MappedBinarySize(self._handle)
+
+    def get(self, index: int) -> Any:
+        """Constructs value #`index` of the document, where the last value is the root."""
+        return _C_MappedBinaryGet(self._handle, index)
+
+    def entry(self, index: int) -> Any:
+        """Value #`index` as a `LazyObject` if it is an object, or constructed otherwise."""
+        type_key, args, refs = _C_MappedBinaryEntry(self._handle, index)
+        if type_key is None:
+            return args[0]
+        return LazyObject(self, index, str(type_key), list(args), list(refs))
+
+    @property
+    def root(self) -> Any:
+        return self.entry(len(self) - 1)
+
+
+class LazyObject:
+    """An object in a `MappedBinary` that is not constructed. Its fields, or its elements for
+    lists and dicts, are read from the document on access, with objects again as `LazyObject`.
+    """
+
+    __slots__ = ("_args", "_refs", "document", "index", "type_key")
+
+    def __init__(
+        self,
+        document: MappedBinary,
+        index: int,
+        type_key: str,
+        args: list[Any],
+        refs: list[int],
+    ) -> None:
+        self.document = document
+        self.index = index
+        self.type_key = type_key
+        self._args = args
+        self._refs = refs
+
+    def __repr__(self) -> str:
+        return f"<LazyObject {self.type_key} #{self.index}>"
+
+    def __len__(self) -> int:
+        return len(self._args) // 2 if self.type_key == "object.Dict" else len(self._args)
+
+    def __iter__(self) -> Iterator[Any]:
+        step = 2 if self.type_key == "object.Dict" else 1
+        return (self._arg(j) for j in range(0, len(self._args), step))
+
+    def __getitem__(self, key: Any) -> Any:
+        if self.type_key == "object.List":
+            return self._arg(range(len(self._args))[key])
+        if self.type_key == "object.Dict":
+            for j in range(0, len(self._args), 2):
+                if self._arg(j) == key:
+                    return self._arg(j + 1)
+            raise KeyError(key)
+        raise TypeError(f"`{self.type_key}` is not a list or a dict")
+
+    def __getattr__(self, name: str) -> Any:
+        for j, field in enumerate(type_key2py_type_info(self.type_key).fields):
+            if field.name == name:
+                return self._arg(j)
+        raise AttributeError(f"`{self.type_key}` has no field `{name}`")
+
+    def items(self) -> Iterator[tuple[Any, Any]]:
+        return ((self._arg(j), self._arg(j + 1)) for j in range(0, len(self._args), 2))
+
+    def materialize(self) -> Any:
+        """Constructs the object, the same as `MappedBinary.get`."""
+        return self.document.get(self.index)
+
+    def _arg(self, j: int) -> Any:
+        ref = self._refs[j]
+        return self._args[j] if ref < 0 else self.document.entry(ref)
+
+
+_C_MappedBinaryOpen = Func.get("mlc.core.MappedBinaryOpen")
+_C_MappedBinaryDelete = Func.get("mlc.core.MappedBinaryDelete")
+_C_MappedBinarySize = Func.get("mlc.core.MappedBinarySize")
+_C_MappedBinaryGet = Func.get("mlc.core.MappedBinaryGet")
+_C_MappedBinaryEntry = Func.get("mlc.core.MappedBinaryEntry")
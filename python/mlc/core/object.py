@@ -4,6 +4,9 @@ import typing
 
 from mlc._cython import PyAny, c_class_core
 
+if typing.TYPE_CHECKING:
+    from .hash_memo import StructuralHashMemo
+
 
 @c_class_core("object.Object")
 class Object(PyAny):
@@ -20,6 +23,13 @@ class Object(PyAny):
     def from_json(json_str: str) -> Object:
         return PyAny._mlc_from_json(json_str)  # type: ignore[attr-defined]
 
+    def to_bytes(self) -> bytes:
+        return PyAny._mlc_to_bytes(self)  # type: ignore[attr-defined]
+
+    @staticmethod
+    def from_bytes(data: bytes) -> Object:
+        return PyAny._mlc_from_bytes(data)  # type: ignore[attr-defined]
+
     def eq_s(
         self,
         other: Object,
@@ -29,9 +39,14 @@ class Object(PyAny):
     ) -> bool:
         return PyAny._mlc_eq_s(self, other, bind_free_vars, assert_mode)  # type: ignore[attr-defined]
 
-    def hash_s(self) -> int:
+    def hash_s(self, *, memo: StructuralHashMemo | None = None) -> int:
+        if memo is not None:
+            return memo.hash_s(self)
         return PyAny._mlc_hash_s(self)  # type: ignore[attr-defined]
 
+    def hash_s128(self) -> int:
+        return PyAny._mlc_hash_s128(self)  # type: ignore[attr-defined]
+
     def eq_ptr(self, other: typing.Any) -> bool:
         return isinstance(other, Object) and self._mlc_address == other._mlc_address
 
@@ -49,6 +49,7 @@ def py_class(
     *,
     init: bool = True,
     repr: bool = True,
+    frozen: bool = False,
     structure: typing.Literal["bind", "nobind", "var"] | None = None,
 ) -> Callable[[type[ClsType]], type[ClsType]]:
     if isinstance(type_key, type):
@@ -56,6 +57,7 @@ def py_class(
             type_key=None,
             init=init,
             repr=repr,
+            frozen=frozen,
             structure=structure,
         )(type_key)
     if structure not in (None, "bind", "nobind", "var"):
@@ -86,6 +88,7 @@ def py_class(
             type_key,
             super_type_cls,
             parent_type_info,
+            frozen,
         )
         num_bytes = _add_field_properties(fields)
         type_info.fields = tuple(fields)
@@ -124,6 +124,7 @@ def inspect_dataclass_fields(  # noqa: PLR0912
     type_key: str,
     type_cls: type,
     parent_type_info: TypeInfo,
+    frozen: bool = False,
 ) -> tuple[list[TypeField], list[Field]]:
     def _get_num_bytes(field_ty: Any) -> int:
         if hasattr(field_ty, "_ctype"):
@@ -146,7 +147,7 @@ def inspect_dataclass_fields(  # noqa: PLR0912
                 name=field_name,
                 offset=-1,
                 num_bytes=_get_num_bytes(field_ty),
-                frozen=False,
+                frozen=frozen,
                 ty=field_ty,
             )
         )
@@ -159,7 +160,7 @@ def inspect_dataclass_fields(  # noqa: PLR0912
                 name=field_name,
                 offset=-1,
                 num_bytes=_get_num_bytes(field_ty),
-                frozen=False,
+                frozen=frozen,
                 ty=field_ty,
             )
         )
@@ -0,0 +1,192 @@
+#include "./common.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <mlc/core/all.h>
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace mlc;
+using ::mlc::base::SizeClassPool;
+using ::mlc::core::ObjectPath;
+
+TEST(SizeClassPool, ReuseFreedBlock) {
+  void *a = SizeClassPool::Alloc(40);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % SizeClassPool::kAlignment, 0u);
+  SizeClassPool::Free(a, 40);
+  // Same size class as 40 bytes
+  void *b = SizeClassPool::Alloc(48);
+  EXPECT_EQ(a, b);
+  SizeClassPool::Free(b, 48);
+}
+
+TEST(SizeClassPool, LargeAllocation) {
+  size_t num_bytes = SizeClassPool::kMaxBytes + 1;
+  char *a = static_cast<char *>(SizeClassPool::Alloc(num_bytes));
+  std::memset(a, 0xab, num_bytes);
+  SizeClassPool::Free(a, num_bytes);
+}
+
+TEST(SizeClassPool, Sized) {
+  for (size_t num_bytes : {size_t(0), size_t(1), size_t(100), SizeClassPool::kMaxBytes, size_t(4096)}) {
+    char *a = static_cast<char *>(SizeClassPool::AllocSized(num_bytes));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % SizeClassPool::kAlignment, 0u);
+    std::memset(a, 0xcd, num_bytes);
+    SizeClassPool::FreeSized(a);
+  }
+}
+
+TEST(SizeClassPool, CrossThreadFree) {
+  constexpr int kNum = 10000;
+  std::vector<void *> ptrs(kNum);
+  std::thread producer([&]() {
+    for (int i = 0; i < kNum; ++i) {
+      ptrs[i] = SizeClassPool::Alloc(32);
+      std::memset(ptrs[i], i & 0xff, 32);
+    }
+  });
+  producer.join();
+  std::thread consumer([&]() {
+    for (int i = 0; i < kNum; ++i) {
+      EXPECT_EQ(static_cast<unsigned char *>(ptrs[i])[31], static_cast<unsigned char>(i & 0xff));
+      SizeClassPool::Free(ptrs[i], 32);
+    }
+  });
+  consumer.join();
+}
+
+TEST(SizeClassPool, ManyBatches) {
+  // Several batches of 32-byte blocks, freed and allocated again in both orders
+  constexpr int kNum = 3 * static_cast<int>(SizeClassPool::kBatchBytes / 32) + 7;
+  std::vector<void *> ptrs(kNum);
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 0; i < kNum; ++i) {
+      ptrs[i] = SizeClassPool::Alloc(32);
+      std::memset(ptrs[i], i & 0xff, 32);
+    }
+    std::vector<void *> sorted = ptrs;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    for (int i = 0; i < kNum; ++i) {
+      EXPECT_EQ(static_cast<unsigned char *>(ptrs[i])[31], static_cast<unsigned char>(i & 0xff));
+    }
+    for (int i = 0; i < kNum; ++i) {
+      SizeClassPool::Free(ptrs[round == 0 ? i : kNum - 1 - i], 32);
+    }
+  }
+}
+
+TEST(PoolObjectAllocator, Objects) {
+  ObjectPath path = ObjectPath::Root()->WithField("a")->WithListIndex(1);
+  EXPECT_EQ(path->length, 3);
+  EXPECT_EQ(path->GetTypeIndex(), ::mlc::core::ObjectPathObj::_type_index);
+  EXPECT_EQ(reinterpret_cast<const MLCAny *>(path.get())->v.deleter,
+            ::mlc::PoolObjectAllocator<::mlc::core::ObjectPathObj>::Deleter);
+  Str str("a string that is padded to the object");
+  EXPECT_EQ(str, "a string that is padded to the object");
+  EXPECT_EQ(reinterpret_cast<const MLCAny *>(str.get())->v.deleter,
+            ::mlc::PoolObjectAllocator<::mlc::core::StrPad>::DeleterArray);
+  Ref<int64_t> boxed(int64_t(42));
+  EXPECT_EQ(*boxed, 42);
+}
+
+TEST(Arena, Transient) {
+  Arena arena;
+  {
+    List<Any> list{1, "a string allocated in the arena", 2.5};
+    ObjectPath path = ObjectPath::Root()->WithField("a");
+    Ref<int64_t> boxed(int64_t(42));
+    EXPECT_GT(arena.NumLive(), 3);
+    EXPECT_EQ(list[1].operator Str(), "a string allocated in the arena");
+  }
+  EXPECT_EQ(arena.NumLive(), 0);
+  EXPECT_EQ(arena.Exit(), 0);
+}
+
+TEST(Arena, Escape) {
+  Optional<List<int64_t>> escaped;
+  {
+    Arena arena;
+    escaped = List<int64_t>{1, 2, 3};
+    EXPECT_EQ(arena.Exit(), 1);
+    EXPECT_EQ(arena.NumLive(), 1);
+  }
+  // Not allocated from the exited arena
+  List<int64_t> after{4};
+  EXPECT_EQ(escaped.value()[2], 3);
+  std::thread([escaped = std::move(escaped)]() mutable { escaped.Reset(); }).join();
+}
+
+TEST(Arena, Nested) {
+  Arena outer;
+  Arena inner;
+  try {
+    outer.Exit();
+    FAIL() << "No exception thrown";
+  } catch (Exception &ex) {
+    EXPECT_STREQ(ex.what(), "Arenas must be exited in reverse order of entering, on the same thread");
+  }
+  EXPECT_EQ(inner.Exit(), 0);
+  EXPECT_EQ(outer.Exit(), 0);
+}
+
+TEST(DeferredFree, LongObjectPathChain) {
+  ObjectPath path = ObjectPath::Root();
+  for (int64_t i = 0; i < 1000000; ++i) {
+    path = path->WithListIndex(i);
+  }
+  EXPECT_EQ(path->length, 1000001);
+  path.Reset();
+}
+
+TEST(DeferredFree, DeeplyNestedList) {
+  List<Any> list;
+  for (int i = 0; i < 100000; ++i) {
+    list = List<Any>{list};
+  }
+  list.Reset();
+}
+
+TEST(DeferredFree, Background) {
+  Func reclaim_in_background(Lib::FuncGetGlobal("mlc.core.ReclaimInBackground"));
+  std::thread::id freed_on;
+  Func func([guard = std::shared_ptr<int>(new int(0), [&freed_on](int *ptr) {
+               freed_on = std::this_thread::get_id();
+               delete ptr;
+             })]() {});
+  ObjectPath path = ObjectPath::Root();
+  for (int64_t i = 0; i < 1000000; ++i) {
+    path = path->WithListIndex(i);
+  }
+  reclaim_in_background(true);
+  func.Reset();
+  path.Reset();
+  reclaim_in_background(false);
+  EXPECT_NE(freed_on, std::thread::id());
+  EXPECT_NE(freed_on, std::this_thread::get_id());
+}
+
+TEST(RefCount, DropOnOtherThread) {
+  bool freed = false;
+  Func func([guard = std::shared_ptr<int>(new int(0), [&freed](int *ptr) {
+               freed = true;
+               delete ptr;
+             })]() {});
+  std::vector<Func> copies(100, func);
+  func.Reset();
+  std::thread([copies = std::move(copies)]() mutable { copies.clear(); }).join();
+  // Under biased reference counting, the object is merged by its owner at the owner's next allocation
+  Str after("allocated after the last reference is dropped");
+  EXPECT_TRUE(freed);
+}
+
+TEST(RefCount, OwnerExited) {
+  Optional<List<Any>> list;
+  std::thread([&list]() { list = List<Any>{1, Str("owned by an exited thread"), List<Any>{2}}; }).join();
+  List<Any> copy = list.value();
+  EXPECT_EQ(copy[1].operator Str(), "owned by an exited thread");
+  list.Reset();
+  copy.Reset();
+}
+
+} // namespace
@@ -420,7 +420,8 @@ struct Checker_Constructor_StrObj_Ref {
 };
 
 TEST(Any, Constructor_C_CharPtr) {
-  const char *str = "hello";
+  // Long enough to not be stored inline as a small string
+  const char *str = "hello, world";
   {
     AnyView v(str);
     Checker_Constructor_RawStr<AnyView>::Check(v, const_cast<char *>(str), nullptr, 0);
@@ -432,7 +433,7 @@ TEST(Any, Constructor_C_CharPtr) {
 }
 
 TEST(Any, Constructor_C_CharArray) {
-  char str[] = "world";
+  char str[] = "world, hello";
   {
     AnyView v(str);
     Checker_Constructor_RawStr<AnyView>::Check(v, str, nullptr, 0);
@@ -444,7 +445,7 @@ TEST(Any, Constructor_C_CharArray) {
 }
 
 TEST(Any, Constructor_StdString) {
-  std::string str = "world";
+  std::string str = "world, hello";
   Checker_Constructor_RawStr<AnyView>::Check(AnyView(str), str.data(), nullptr, 0);
   Checker_Constructor_RawStr<AnyView>::Check(AnyView(std::move(str)), str.data(), nullptr, 0);
   Checker_Constructor_RawStr<Any>::Check(Any(str), str.data(), nullptr, 1);
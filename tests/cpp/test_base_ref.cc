@@ -8,7 +8,7 @@ using namespace mlc;
 
 // Helper function to get ref count
 template <typename T> int32_t GetRefCount(const T &ref) {
-  return reinterpret_cast<const MLCObjPtr &>(ref).ptr->ref_cnt;
+  return ::mlc::base::RefCount(reinterpret_cast<const MLCObjPtr &>(ref).ptr);
 }
 
 // Test class
@@ -84,7 +84,7 @@ TEST(Ref, MoveConstructorFromDerived) {
 TEST(Ref, ConstructorFromRawPointer) {
   // Testing method Ref<TestObj>::Ref(TestObj*)
   TestObj *raw_ptr = ::mlc::base::AllocatorOf<TestObj>::New(42);
-  EXPECT_EQ(raw_ptr->_mlc_header.ref_cnt, 0);
+  EXPECT_EQ(::mlc::base::RefCount(&raw_ptr->_mlc_header), 0);
   Ref<TestObj> ref(raw_ptr);
   EXPECT_EQ(ref->data, 42);
   EXPECT_EQ(GetRefCount(ref), 1);
@@ -208,4 +208,26 @@ TEST(FuncTraits, Signature) {
                  "(0: bool, 1: Optional<bool>, 2: Ref<bool>) -> Optional<bool>");
 }
 
+void CheckPlan(const MLCVisitOp *plan, std::vector<std::pair<int32_t, const char *>> expected) {
+  ASSERT_NE(plan, nullptr);
+  size_t i = 0;
+  for (; plan[i].kind != kMLCVisitEnd; ++i) {
+    ASSERT_LT(i, expected.size());
+    EXPECT_EQ(plan[i].kind, expected[i].first);
+    EXPECT_STREQ(plan[i].field->name, expected[i].second);
+    EXPECT_EQ(plan[i].offset, plan[i].field->offset);
+  }
+  EXPECT_EQ(i, expected.size());
+}
+
+TEST(TypeInfo, VisitPlans) {
+  MLCTypeInfo *info = Lib::GetTypeInfo(::mlc::core::ObjectPathObj::_type_index);
+  CheckPlan(info->field_plan, {{kMLCVisitInt32, "kind"},
+                               {kMLCVisitAny, "key"},
+                               {kMLCVisitOptionalObjectRef, "prev"},
+                               {kMLCVisitInt64, "length"}});
+  CheckPlan(info->ref_plan, {{kMLCVisitAny, "key"}, {kMLCVisitOptionalObjectRef, "prev"}});
+  EXPECT_EQ(info->structure_plan, nullptr);
+}
+
 } // namespace
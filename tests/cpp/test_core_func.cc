@@ -111,9 +111,9 @@ TEST(Func, FunctionReturningRef) {
 }
 
 TEST(Func, ArgumentObjRawPtr) {
-  Func f1([](Object *obj) { EXPECT_EQ(reinterpret_cast<MLCAny *>(obj)->ref_cnt, 1); });
-  Func f2([](ObjectRef obj) { EXPECT_EQ(reinterpret_cast<MLCAny *>(obj.get())->ref_cnt, 2); });
-  Func f3([](Ref<Object> obj) { EXPECT_EQ(reinterpret_cast<MLCAny *>(obj.get())->ref_cnt, 2); });
+  Func f1([](Object *obj) { EXPECT_EQ(::mlc::base::RefCount(reinterpret_cast<MLCAny *>(obj)), 1); });
+  Func f2([](ObjectRef obj) { EXPECT_EQ(::mlc::base::RefCount(reinterpret_cast<MLCAny *>(obj.get())), 2); });
+  Func f3([](Ref<Object> obj) { EXPECT_EQ(::mlc::base::RefCount(reinterpret_cast<MLCAny *>(obj.get())), 2); });
   ObjectRef obj;
   f1(obj);
   f2(obj);
@@ -128,10 +128,10 @@ TEST(Func, ArgumentObjRawPtr) {
 }
 
 TEST(Func, ArgumentRawStrToStrObj) {
-  Func f1([](StrObj *str) { EXPECT_EQ(reinterpret_cast<MLCStr *>(str)->_mlc_header.ref_cnt, 1); });
-  Func f2([](Ref<StrObj> str) { EXPECT_EQ(reinterpret_cast<MLCStr *>(str.get())->_mlc_header.ref_cnt, 1); });
-  Func f3([](Str str) { EXPECT_EQ(reinterpret_cast<MLCStr *>(str.get())->_mlc_header.ref_cnt, 1); });
-  Func f4([](Optional<Str> str) { EXPECT_EQ(reinterpret_cast<MLCStr *>(str.get())->_mlc_header.ref_cnt, 1); });
+  Func f1([](StrObj *str) { EXPECT_EQ(::mlc::base::RefCount(reinterpret_cast<MLCAny *>(str)), 1); });
+  Func f2([](Ref<StrObj> str) { EXPECT_EQ(::mlc::base::RefCount(reinterpret_cast<MLCAny *>(str.get())), 1); });
+  Func f3([](Str str) { EXPECT_EQ(::mlc::base::RefCount(reinterpret_cast<MLCAny *>(str.get())), 1); });
+  Func f4([](Optional<Str> str) { EXPECT_EQ(::mlc::base::RefCount(reinterpret_cast<MLCAny *>(str.get())), 1); });
   std::string long_str(1000, 'a');
   const char *c_str = long_str.c_str();
   char c_array[] = "Hello world";
@@ -198,4 +198,27 @@ TEST(Func, ReturnTypeMismatch_0) {
   }
 }
 
+TEST(Func, GlobalOverrideFreesReplaced) {
+  std::shared_ptr<int> token = std::make_shared<int>(0);
+  Lib::FuncSetGlobal("mlc.testing.override_target", Func([token](int64_t a) { return a; }).get(), true);
+  EXPECT_EQ(token.use_count(), 2);
+  Lib::FuncSetGlobal("mlc.testing.override_target", Func([](int64_t a) { return a + 1; }).get(), true);
+  EXPECT_EQ(token.use_count(), 1);
+  EXPECT_EQ(Func(Lib::FuncGetGlobal("mlc.testing.override_target"))(1).operator int64_t(), 2);
+}
+
+TEST(Func, MarkImmortal) {
+  Func func([](int64_t a) { return a + 1; });
+  MLCAny *header = reinterpret_cast<MLCAny *>(func.get());
+  EXPECT_FALSE(::mlc::base::IsImmortal(header));
+  ::mlc::base::MarkImmortal(header);
+  EXPECT_TRUE(::mlc::base::IsImmortal(header));
+  {
+    Func copy = func;
+    EXPECT_EQ(copy(1).operator int64_t(), 2);
+  }
+  EXPECT_EQ(header->ref_cnt, ::mlc::base::kImmortalRefCnt);
+  header->ref_cnt = 1; // Let `func` free the object to keep the leak checker quiet
+}
+
 } // namespace
@@ -157,7 +157,7 @@ TEST(ListRefTest, ObjectLifetime) {
   EXPECT_EQ(list.size(), 1);
   EXPECT_NE(list[0].get(), nullptr);
   EXPECT_EQ(list[0]->value, 42);
-  EXPECT_EQ(reinterpret_cast<MLCAny *>(ptr)->ref_cnt, 1);
+  EXPECT_EQ(::mlc::base::RefCount(reinterpret_cast<MLCAny *>(ptr)), 1);
 }
 
 // Iterator tests
@@ -237,7 +237,8 @@ TEST(ListAnyTest, IterationWithTypeChecking) {
       type_checks.push_back(1);
     } else if (item.type_index == static_cast<int32_t>(MLCTypeIndex::kMLCFloat)) {
       type_checks.push_back(2);
-    } else if (item.type_index == static_cast<int32_t>(MLCTypeIndex::kMLCStr)) {
+    } else if (item.type_index == static_cast<int32_t>(MLCTypeIndex::kMLCStr) ||
+               item.type_index == static_cast<int32_t>(MLCTypeIndex::kMLCSmallStr)) {
       type_checks.push_back(3);
     } else if (item.type_index == TestTypeObj::_type_index) {
       type_checks.push_back(4);
@@ -156,6 +156,90 @@ TEST(Str, Comparison) {
   EXPECT_TRUE(str1 != std_str2);
 }
 
+TEST(Str, CachedHash) {
+  Str str("Hello, World!");
+  const MLCStr *raw = reinterpret_cast<const MLCStr *>(str.get());
+  EXPECT_EQ(raw->hash, 0u);
+  uint64_t hash = str.Hash();
+  EXPECT_EQ(hash, ::mlc::base::StrHash("Hello, World!"));
+  EXPECT_EQ(raw->hash, hash);
+  EXPECT_EQ(::mlc::base::AnyHash(AnyView(str)), hash);
+}
+
+TEST(Str, Intern) {
+  Str a = Str::Intern("identifier");
+  Str b = Str::Intern(Str("identifier"));
+  Str c = Str::Intern("another_identifier");
+  EXPECT_EQ(a.get(), b.get());
+  EXPECT_NE(a.get(), c.get());
+  EXPECT_EQ(a, "identifier");
+  EXPECT_EQ(reinterpret_cast<const MLCStr *>(a.get())->hash, ::mlc::base::StrHash("identifier"));
+  Str d("identifier");
+  EXPECT_TRUE(::mlc::base::AnyEqual(AnyView(a), AnyView(d)));
+  EXPECT_FALSE(::mlc::base::AnyEqual(AnyView(a), AnyView(c)));
+  EXPECT_STREQ(Lib::GetTypeInfo(kMLCStr)->type_key, Str::Intern("object.Str")->data());
+  EXPECT_EQ(Lib::GetTypeInfo(kMLCStr)->type_key, Str::Intern("object.Str")->data());
+}
+
+TEST(Str, InternImmortal) {
+  Str a = Str::Intern("an_interned_identifier");
+  const MLCAny *header = reinterpret_cast<const MLCAny *>(a.get());
+  EXPECT_TRUE(::mlc::base::IsImmortal(header));
+  int32_t ref_cnt = header->ref_cnt;
+  {
+    Str b = a;
+    Any c = b;
+    EXPECT_EQ(header->ref_cnt, ref_cnt);
+  }
+  EXPECT_EQ(header->ref_cnt, ref_cnt);
+}
+
+TEST(Str, InternCopiesSource) {
+  Str src("a_mutable_interned_identifier");
+  Str a = Str::Intern(src);
+  EXPECT_NE(a.get(), src.get());
+  src->pop_back();
+  EXPECT_EQ(a, "a_mutable_interned_identifier");
+  EXPECT_EQ(Str::Intern("a_mutable_interned_identifier").get(), a.get());
+}
+
+TEST(Str, SmallStr) {
+  Any small("abc");
+  EXPECT_EQ(small.type_index, static_cast<int32_t>(MLCTypeIndex::kMLCSmallStr));
+  EXPECT_EQ(small.small_len, 3);
+  EXPECT_STREQ(small.operator const char *(), "abc");
+  EXPECT_EQ(small.operator std::string(), "abc");
+  EXPECT_STREQ(small.str()->c_str(), "\"abc\"");
+  Any seven("abcdefg");
+  EXPECT_EQ(seven.type_index, static_cast<int32_t>(MLCTypeIndex::kMLCSmallStr));
+  Any eight("abcdefgh");
+  EXPECT_EQ(eight.type_index, static_cast<int32_t>(MLCTypeIndex::kMLCStr));
+  Any empty("");
+  EXPECT_EQ(empty.type_index, static_cast<int32_t>(MLCTypeIndex::kMLCSmallStr));
+  EXPECT_EQ(empty.small_len, 0);
+  // Conversion to heap-allocated strings
+  Str heap = small;
+  EXPECT_EQ(heap, "abc");
+  ObjectRef obj = small;
+  EXPECT_EQ(obj->GetTypeIndex(), static_cast<int32_t>(MLCTypeIndex::kMLCStr));
+  // Hashing and equality agree with heap-allocated strings
+  EXPECT_EQ(::mlc::base::AnyHash(small), ::mlc::base::AnyHash(AnyView(heap)));
+  EXPECT_TRUE(::mlc::base::AnyEqual(small, AnyView(heap)));
+  EXPECT_TRUE(::mlc::base::AnyEqual(AnyView(heap), small));
+  EXPECT_TRUE(::mlc::base::AnyEqual(small, Any("abc")));
+  EXPECT_FALSE(::mlc::base::AnyEqual(small, Any("abd")));
+  EXPECT_FALSE(::mlc::base::AnyEqual(small, Any("abcd")));
+  EXPECT_FALSE(::mlc::base::AnyEqual(small, AnyView(Str("abd"))));
+  // Dictionary keys
+  UDict dict{{Str("abc"), 1}, {"xyz", 2}};
+  EXPECT_EQ(dict.size(), 2);
+  EXPECT_EQ(dict.at("abc").operator int(), 1);
+  EXPECT_EQ(dict.at(Str("xyz")).operator int(), 2);
+  dict["abc"] = 3;
+  EXPECT_EQ(dict.size(), 2);
+  EXPECT_EQ(dict.at(Str("abc")).operator int(), 3);
+}
+
 TEST(Str, StreamOperator) {
   Str str("Hello, World!");
   std::ostringstream oss;
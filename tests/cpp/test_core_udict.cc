@@ -282,4 +282,36 @@ TEST(UDict, ReverseIteratorModification) {
   EXPECT_EQ(dict["key3"].operator int(), 6);
 }
 
+TEST(UDict, RandomInsertEraseLookup) {
+  UDict dict;
+  std::unordered_map<int64_t, int64_t> expected;
+  uint64_t state = 42;
+  auto next = [&state]() -> int64_t {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<int64_t>(state >> 33) % 2048;
+  };
+  for (int i = 0; i < 20000; ++i) {
+    int64_t key = next();
+    int64_t op = next() % 3;
+    std::string str_key = "key_" + std::to_string(key);
+    if (op == 0) {
+      dict[key] = i;
+      dict[str_key] = i;
+      expected[key] = i;
+    } else if (op == 1 && expected.count(key)) {
+      dict->erase(key);
+      dict->erase(str_key);
+      expected.erase(key);
+    } else {
+      EXPECT_EQ(dict->count(key), static_cast<int64_t>(expected.count(key)));
+      EXPECT_EQ(dict->count(str_key), static_cast<int64_t>(expected.count(key)));
+    }
+  }
+  EXPECT_EQ(dict->size(), static_cast<int64_t>(expected.size() * 2));
+  for (const auto &kv : expected) {
+    EXPECT_EQ(dict->at(kv.first).operator int64_t(), kv.second);
+    EXPECT_EQ(dict->at("key_" + std::to_string(kv.first)).operator int64_t(), kv.second);
+  }
+}
+
 } // namespace
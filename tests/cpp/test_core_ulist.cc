@@ -200,4 +200,25 @@ TEST(UList, LargeList) {
   }
 }
 
+TEST(UList, Rewrite) {
+  UList leaf{1, 2};
+  UList single{3};
+  UList root{leaf, single, UList{leaf, single}};
+  int num_calls = 0;
+  Func unwrap_single([&num_calls](UList list) -> Any {
+    ++num_calls;
+    return list.size() == 1 ? list[0] : Any(list);
+  });
+  UList ret = Lib::Rewrite(root, unwrap_single.get());
+  EXPECT_EQ(num_calls, 4);
+  EXPECT_NE(ret.get(), root.get());
+  EXPECT_EQ(ret[0].operator UList().get(), leaf.get());
+  EXPECT_EQ(ret[1].operator int(), 3);
+  UList inner = ret[2];
+  EXPECT_EQ(inner[0].operator UList().get(), leaf.get());
+  EXPECT_EQ(inner[1].operator int(), 3);
+  Func identity([](AnyView v) -> Any { return v; });
+  EXPECT_EQ(Lib::Rewrite(root, identity.get()).operator UList().get(), root.get());
+}
+
 } // namespace
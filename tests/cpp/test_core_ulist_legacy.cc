@@ -23,7 +23,7 @@ TEST(Legacy_UList_Constructor, Default) {
   MLCList *list_ptr = reinterpret_cast<MLCList *>(list.get());
   ASSERT_NE(list_ptr, nullptr);
   EXPECT_EQ(list_ptr->_mlc_header.type_index, static_cast<int32_t>(MLCTypeIndex::kMLCList));
-  EXPECT_EQ(list_ptr->_mlc_header.ref_cnt, 1);
+  EXPECT_EQ(::mlc::base::RefCount(&list_ptr->_mlc_header), 1);
   EXPECT_NE(list_ptr->_mlc_header.v.deleter, nullptr);
   EXPECT_EQ(list_ptr->capacity, 0);
   EXPECT_EQ(list_ptr->size, 0);
@@ -37,7 +37,7 @@ TEST(Legacy_UList_Constructor, InitializerList) {
     auto *list_ptr = reinterpret_cast<const MLCList *>(src);
     ASSERT_NE(list_ptr, nullptr);
     EXPECT_EQ(list_ptr->_mlc_header.type_index, static_cast<int32_t>(MLCTypeIndex::kMLCList));
-    EXPECT_EQ(list_ptr->_mlc_header.ref_cnt, 1);
+    EXPECT_EQ(::mlc::base::RefCount(&list_ptr->_mlc_header), 1);
     EXPECT_NE(list_ptr->_mlc_header.v.deleter, nullptr);
     EXPECT_EQ(list_ptr->capacity, 7);
     EXPECT_EQ(list_ptr->size, 7);
@@ -58,7 +58,7 @@ TEST(Legacy_UList_PushBack, POD) {
   MLCList *list_ptr = reinterpret_cast<MLCList *>(list.get());
   ASSERT_NE(list_ptr, nullptr);
   EXPECT_EQ(list_ptr->_mlc_header.type_index, static_cast<int32_t>(MLCTypeIndex::kMLCList));
-  EXPECT_EQ(list_ptr->_mlc_header.ref_cnt, 1);
+  EXPECT_EQ(::mlc::base::RefCount(&list_ptr->_mlc_header), 1);
   EXPECT_NE(list_ptr->_mlc_header.v.deleter, nullptr);
   EXPECT_EQ(list_ptr->capacity, 2);
   EXPECT_EQ(list_ptr->size, 2);
@@ -76,7 +76,7 @@ TEST(Legacy_UList_PushBack, Obj) {
   MLCList *list_ptr = reinterpret_cast<MLCList *>(list.get());
   ASSERT_NE(list_ptr, nullptr);
   EXPECT_EQ(list_ptr->_mlc_header.type_index, static_cast<int32_t>(MLCTypeIndex::kMLCList));
-  EXPECT_EQ(list_ptr->_mlc_header.ref_cnt, 1);
+  EXPECT_EQ(::mlc::base::RefCount(&list_ptr->_mlc_header), 1);
   EXPECT_NE(list_ptr->_mlc_header.v.deleter, nullptr);
   EXPECT_EQ(list_ptr->capacity, 2);
   EXPECT_EQ(list_ptr->size, 2);
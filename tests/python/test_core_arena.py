@@ -0,0 +1,51 @@
+import mlc
+import numpy as np
+import pytest
+
+
+def test_arena_transient() -> None:
+    with mlc.Arena() as arena:
+        lst = mlc.List([1, "a string allocated in the arena", mlc.List([2.5])])
+        assert lst[1] == "a string allocated in the arena"
+        del lst
+    assert arena.num_escaped == 0
+
+
+def test_arena_escape() -> None:
+    with mlc.Arena() as arena:
+        lst = mlc.List([1, "a string allocated in the arena", mlc.List([2.5])])
+    assert arena.num_escaped == 3
+    assert lst[1] == "a string allocated in the arena"
+    assert lst[2][0] == 2.5
+    del lst
+
+
+def test_arena_printer() -> None:
+    node = mlc.printer.ast.Call(
+        mlc.printer.ast.Id("function_name"),
+        [mlc.printer.ast.Literal(1), mlc.printer.ast.Id("x")],
+        [],
+        [],
+    )
+    with mlc.Arena() as arena:
+        # The returned `Str` would otherwise hold on to its arena-allocated buffer
+        text = str(node.to_python())
+    assert text == "function_name(1, x)"
+    assert arena.num_escaped == 0
+
+
+def test_arena_tensor() -> None:
+    a = np.arange(6, dtype=np.int32)
+    with mlc.Arena() as arena:
+        b = mlc.Tensor(a)
+        c = mlc.Tensor.from_base64(b.base64())
+        assert np.array_equal(c.numpy(), a)
+        del b, c
+    assert arena.num_escaped == 0
+
+
+def test_arena_reenter() -> None:
+    arena = mlc.Arena()
+    with arena:
+        with pytest.raises(ValueError, match="already entered"):
+            arena.__enter__()
@@ -66,6 +66,16 @@ def test_dict_get() -> None:
     assert a.get(5) is None
 
 
+def test_dict_small_str_key() -> None:
+    a = Dict({"a": 1, "bc": "de", "a long key": 2})
+    b = Dict.from_json(a.json())
+    assert b["a"] == 1
+    assert b["bc"] == "de"
+    assert b["a long key"] == 2
+    assert a.eq_s(b)
+    assert a.hash_s() == b.hash_s()
+
+
 def test_dict_str() -> None:
     a = Dict({i: i * i for i in range(1, 5)})
     assert "{" + ", ".join(sorted(str(a)[1:-1].split(", "))) + "}" == "{1: 1, 2: 4, 3: 9, 4: 16}"
@@ -50,3 +50,33 @@ def test_func_init() -> None:
     func = Func(lambda x: x + 1)
     assert func(1) == 2
     assert str(func).startswith("object.Func@0x")
+
+
+def test_str_intern() -> None:
+    a = mlc.str_intern("identifier")
+    b = mlc.str_intern(mlc.Str("identifier"))
+    assert isinstance(a, mlc.Str) and a == "identifier"
+    assert isinstance(b, mlc.Str) and b == "identifier"
+    d = mlc.Dict({a: 1})
+    assert d["identifier"] == 1
+    assert d[b] == 1
+
+
+def test_reclaim_in_background() -> None:
+    freed = []
+
+    class Guard:
+        def __del__(self) -> None:
+            freed.append(True)
+
+    guard = Guard()
+    lst = mlc.List([Func(lambda: guard)])
+    del guard
+    for _ in range(10000):
+        lst = mlc.List([lst])
+    mlc.reclaim_in_background(True)
+    try:
+        del lst
+    finally:
+        mlc.reclaim_in_background(False)
+    assert freed == [True]
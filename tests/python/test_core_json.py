@@ -1,6 +1,7 @@
 import json
 
 import mlc
+import pytest
 
 
 def test_json_loads_bool() -> None:
@@ -16,3 +17,26 @@ def test_json_loads_none() -> None:
     result = mlc.json_loads(src)
     assert isinstance(result, mlc.List) and len(result) == 1
     assert result[0] is None
+
+
+def test_json_loads_str() -> None:
+    strs = ["", "a" * 100, 'x"y' * 30, "\\" * 63 + '"', "tab\tnew\nline", "é中", "\\\\\\"]
+    src = json.dumps({"key": strs, "more": [{"key": s} for s in strs]})
+    result = mlc.json_loads(src)
+    assert list(result["key"]) == strs
+    assert [item["key"] for item in result["more"]] == strs
+
+
+def test_json_loads_number() -> None:
+    nums = [0, -7, 123456789012345678, -(2**63), 2**63 - 1, 1.5, -2.5e-3, 1e100]
+    result = mlc.json_loads(json.dumps(nums))
+    assert list(result) == nums
+
+
+def test_json_loads_error() -> None:
+    with pytest.raises(ValueError, match="position 11: Unterminated string"):
+        mlc.json_loads('["abc", "de')
+    with pytest.raises(ValueError, match="position 4: Extra data after valid JSON"):
+        mlc.json_loads("[1] 2")
+    with pytest.raises(ValueError, match="position 7: Expected ','"):
+        mlc.json_loads('["\\""  1]')
@@ -2,7 +2,7 @@ from collections.abc import Sequence
 from typing import Any
 
 import pytest
-from mlc import DataType, Device, List
+from mlc import DataType, Device, List, Str
 
 
 @pytest.mark.parametrize("index", [-5, 4])
@@ -25,6 +25,17 @@ def test_list_str() -> None:
     assert str(a) == '[1, "a", int32, cpu:0]'
 
 
+def test_list_small_str() -> None:
+    a = List(["", "abc", "abcdefg", "abcdefgh"])
+    assert list(a) == ["", "abc", "abcdefg", "abcdefgh"]
+    assert all(isinstance(x, Str) for x in a)
+    assert str(a) == '["", "abc", "abcdefg", "abcdefgh"]'
+    b = List.from_json(a.json())
+    assert a.eq_s(b)
+    assert a.hash_s() == b.hash_s()
+    assert not a.eq_s(List(["", "abd", "abcdefg", "abcdefgh"]))
+
+
 def test_list_insert_middle() -> None:
     a = List([1, 2, 4, 5])
     a.insert(2, 3)
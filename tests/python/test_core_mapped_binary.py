@@ -0,0 +1,80 @@
+import pathlib
+from concurrent.futures import ThreadPoolExecutor
+from typing import Any
+
+import mlc
+import numpy as np
+import pytest
+
+
+@mlc.dataclasses.py_class("mlc.testing.mapped_binary.Func")
+class MappedFunc(mlc.PyClass):
+    name: str
+    body: list[Any]
+    weight: Any = None
+
+
+def _dump(tmp_path: pathlib.Path, obj: mlc.Object) -> pathlib.Path:
+    path = tmp_path / "module.mlcb"
+    mlc.dump(obj, path, binary=True)
+    return path
+
+
+def test_mapped_binary_lazy_root(tmp_path: pathlib.Path) -> None:
+    shared = mlc.List([1, "two", 3.0])
+    funcs = mlc.Dict({f"f{i}": MappedFunc(f"f{i}", mlc.List([i, shared])) for i in range(100)})
+    doc = mlc.MappedBinary(_dump(tmp_path, mlc.List([funcs, shared])))
+    root = doc.root
+    assert isinstance(root, mlc.LazyObject)
+    assert root.type_key == "object.List"
+    assert len(root) == 2
+    lazy_funcs = root[0]
+    assert len(lazy_funcs) == 100
+    lazy_func = lazy_funcs["f42"]
+    assert lazy_func.type_key == "mlc.testing.mapped_binary.Func"
+    assert lazy_func.name == "f42"
+    assert lazy_func.weight is None
+    func = lazy_func.materialize()
+    assert isinstance(func, MappedFunc)
+    assert func.name == "f42" and func.body[0] == 42
+    # Values constructed once are shared, with the root and with each other
+    assert func.body[1].eq_ptr(root[1].materialize())
+    assert doc.get(len(doc) - 1)[0]["f42"].eq_ptr(func)
+    assert list(root[1]) == [1, "two", 3.0]
+
+
+def test_mapped_binary_threads(tmp_path: pathlib.Path) -> None:
+    shared = mlc.List([1, "two", 3.0])
+    funcs = mlc.List([MappedFunc(f"f{i}", mlc.List([i, shared])) for i in range(200)])
+    doc = mlc.MappedBinary(_dump(tmp_path, funcs))
+
+    def visit(offset: int) -> list[Any]:
+        return [doc.entry((i + offset) % len(doc)) for i in range(len(doc))] + [doc.get(len(doc) - 1)]
+
+    with ThreadPoolExecutor(max_workers=8) as pool:
+        results = list(pool.map(visit, range(0, 400, 50)))
+    root = doc.get(len(doc) - 1)
+    for result in results:
+        assert result[-1].eq_ptr(root)
+    assert root[7].body[1].eq_ptr(root[8].body[1])
+
+
+def test_mapped_binary_tensor_view(tmp_path: pathlib.Path) -> None:
+    weight = np.arange(1000, dtype=np.float32).reshape(10, 100)
+    path = _dump(tmp_path, MappedFunc("f", mlc.List([]), mlc.Tensor(weight)))
+    doc = mlc.MappedBinary(path)
+    tensor = doc.root.weight
+    assert isinstance(tensor, mlc.Tensor)
+    del doc
+    assert np.array_equal(tensor.numpy(), weight)
+    assert tensor.numpy().ctypes.data % 64 == 0
+
+
+def test_mapped_binary_error(tmp_path: pathlib.Path) -> None:
+    path = tmp_path / "bad.mlcb"
+    path.write_bytes(b"\0" * 64)
+    with pytest.raises(ValueError, match="Magic number mismatch"):
+        mlc.MappedBinary(path)
+    doc = mlc.MappedBinary(_dump(tmp_path, mlc.List([1])))
+    with pytest.raises(IndexError):
+        doc.get(len(doc))
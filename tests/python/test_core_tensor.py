@@ -1,3 +1,7 @@
+import base64
+import io
+import pathlib
+
 import mlc
 import numpy as np
 import pytest
@@ -111,6 +115,36 @@ def test_tensor_base64_float16() -> None:
     assert torch.equal(a.torch(), b.torch())
 
 
+@pytest.mark.parametrize("size", [0, 1, 2, 3, 11, 12, 13, 24, 35, 36, 47, 48, 95, 96, 97, 1000])
+def test_tensor_base64_sizes(size: int) -> None:
+    # Sizes around the block widths of the vectorized codecs
+    data = np.random.default_rng(size).integers(0, 256, size=size, dtype=np.uint8)
+    a = mlc.Tensor(data)
+    encoded = a.base64()
+    raw = base64.b64decode(encoded)
+    assert base64.b64encode(raw).decode() == encoded
+    assert raw[len(raw) - size :] == data.tobytes()
+    b = mlc.Tensor.from_base64(encoded)
+    assert np.array_equal(b.numpy(), data)
+
+
+@pytest.mark.parametrize("pos", [0, 17, 40, 100, -3])
+def test_tensor_base64_invalid(pos: int) -> None:
+    encoded = mlc.Tensor(np.arange(64, dtype=np.int32)).base64()
+    pos %= len(encoded)
+    corrupted = encoded[:pos] + "!" + encoded[pos + 1 :]
+    with pytest.raises(ValueError, match="Invalid character"):
+        mlc.Tensor.from_base64(corrupted)
+
+
+@pytest.mark.parametrize("dim", [-1, 5, 2**40, 2**62])
+def test_tensor_base64_invalid_shape(dim: int) -> None:
+    raw = bytearray(base64.b64decode(mlc.Tensor(np.arange(4, dtype=np.int32)).base64()))
+    raw[16:24] = dim.to_bytes(8, "little", signed=True)
+    with pytest.raises(ValueError, match="LoadDLPack"):
+        mlc.Tensor.from_base64(base64.b64encode(raw).decode())
+
+
 def test_torch_strides() -> None:
     a = torch.empty(4, 1, 6, 1, 10, dtype=torch.int16)
     a = torch.from_dlpack(torch.to_dlpack(a))
@@ -128,3 +162,91 @@ def test_tensor_serialize() -> None:
     assert isinstance(b[1], mlc.Tensor)
     assert b[0].eq_ptr(b[1])
     assert np.array_equal(a.numpy(), b[0].numpy())
+
+
+def test_tensor_serialize_bytes() -> None:
+    a = mlc.Tensor(np.arange(24, dtype=np.int16).reshape(2, 3, 4))
+    c = mlc.Tensor(np.linspace(0, 1, 5, dtype=np.float64))
+    b = mlc.List.from_bytes(mlc.List([a, c, a]).to_bytes())
+    assert isinstance(b, mlc.List)
+    assert len(b) == 3
+    assert b[0].eq_ptr(b[2])
+    assert np.array_equal(a.numpy(), b[0].numpy())
+    assert np.array_equal(c.numpy(), b[1].numpy())
+
+
+def test_tensor_serialize_escaped() -> None:
+    a = mlc.Tensor(np.arange(256, dtype=np.uint8))
+    c = mlc.Tensor(np.arange(255, -1, -1, dtype=np.uint8))
+    a_json = mlc.List([a, c]).json()
+    tensors_begin = a_json.index('"tensors"')
+    # Escaped slashes are valid JSON, and make every tensor go through the unescaping path
+    escaped = a_json[:tensors_begin] + a_json[tensors_begin:].replace("/", "\\/")
+    b = mlc.List.from_json(escaped)
+    assert np.array_equal(a.numpy(), b[0].numpy())
+    assert np.array_equal(c.numpy(), b[1].numpy())
+
+
+@pytest.mark.parametrize("binary", [False, True])
+def test_tensor_dump_load(tmp_path: pathlib.Path, binary: bool) -> None:
+    # Larger than a stream chunk, and of a length that is not a multiple of 3
+    a = mlc.Tensor(np.arange(700_001, dtype=np.float32))
+    c = mlc.Tensor(np.arange(5, dtype=np.int8))
+    src = mlc.List([a, c, a])
+    path = tmp_path / "tensors.bin"
+    mlc.dump(src, path, binary=binary)
+    b = mlc.load(path, binary=binary)
+    assert b[0].eq_ptr(b[2])
+    assert np.array_equal(a.numpy(), b[0].numpy())
+    assert np.array_equal(c.numpy(), b[1].numpy())
+    if not binary:
+        assert path.read_text() == src.json()
+    else:
+        assert path.read_bytes() == src.to_bytes()
+
+
+def test_tensor_dump_load_tensor_file(tmp_path: pathlib.Path) -> None:
+    a = mlc.Tensor(np.arange(1000, dtype=np.float32).reshape(10, 100))
+    c = mlc.Tensor(np.arange(5, dtype=np.int8))
+    src = mlc.List([a, c, a])
+    path, tensor_path = tmp_path / "module.json", tmp_path / "module.tensors"
+    mlc.dump(src, path, tensor_file=tensor_path)
+    assert '"tensors": [[' in path.read_text()
+    for b in [
+        mlc.load(path, tensor_file=tensor_path),
+        mlc.load(io.BytesIO(path.read_bytes()), tensor_file=tensor_path),
+    ]:
+        assert b[0].eq_ptr(b[2])
+        assert np.array_equal(a.numpy(), b[0].numpy())
+        assert np.array_equal(c.numpy(), b[1].numpy())
+        # Views into the mapping, with the raw data aligned
+        assert b[0].numpy().ctypes.data % 64 == 0
+        assert b[1].numpy().ctypes.data % 64 == 0
+    with pytest.raises(ValueError, match="stored in a tensor file, which is not given"):
+        mlc.load(path)
+    tensor_path.write_bytes(tensor_path.read_bytes()[:100])
+    with pytest.raises(ValueError, match="out of the bounds of the mapped file"):
+        mlc.load(path, tensor_file=tensor_path)
+    with pytest.raises(ValueError, match="only supported by JSON documents"):
+        mlc.dump(src, tmp_path / "module.bin", binary=True, tensor_file=tensor_path)
+    assert not (tmp_path / "module.bin").exists()
+
+
+def test_tensor_serialize_many() -> None:
+    # Enough data for the tensors to be decoded in parallel, in the background of the values before them
+    weights = [mlc.Tensor(np.full((64, 65), i, dtype=np.float32)) for i in range(100)]
+    names = mlc.List([f"w{i}" for i in range(100)])
+    b = mlc.List.from_json(mlc.List([names, mlc.List(weights), weights[7]]).json())
+    assert list(b[0]) == list(names)
+    assert b[1][7].eq_ptr(b[2])
+    for a, c in zip(weights, b[1]):
+        assert np.array_equal(a.numpy(), c.numpy())
+
+
+def test_tensor_serialize_many_invalid() -> None:
+    weights = mlc.List([mlc.Tensor(np.zeros(10_000, dtype=np.float32)) for _ in range(10)])
+    a_json = mlc.List([1, weights]).json()
+    tensors_begin = a_json.index('"tensors"')
+    corrupted = a_json[: tensors_begin + 100] + "!" + a_json[tensors_begin + 101 :]
+    with pytest.raises(ValueError, match="Invalid character"):
+        mlc.List.from_json(corrupted)
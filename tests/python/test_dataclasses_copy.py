@@ -1,4 +1,5 @@
 import copy
+from typing import Any, Optional
 
 import mlc
 import pytest
@@ -270,3 +271,36 @@ def test_copy_deep_dataclass(test_obj: CustomInit) -> None:
     assert src != dst
     assert src.a == dst.a
     assert src.b == dst.b
+
+
+@mlc.py_class
+class CopyNode(mlc.PyClass):
+    value: int
+    children: list[Any]
+    label: Optional[str]
+
+
+def test_copy_deep_memberwise(monkeypatch: pytest.MonkeyPatch) -> None:
+    num_inits = 0
+    mlc_init = CopyNode._mlc_init
+
+    def counted_init(self: CopyNode, *args: Any) -> None:
+        nonlocal num_inits
+        num_inits += 1
+        mlc_init(self, *args)
+
+    leaf = CopyNode(1, [], "leaf")
+    root = CopyNode(2, [leaf, leaf, CopyNode(3, [leaf], None)], None)
+    monkeypatch.setattr(CopyNode, "_mlc_init", counted_init)
+    dst = copy.deepcopy(root)
+    assert num_inits == 0
+    assert dst.value == 2 and len(dst.children) == 3
+    assert not dst.children[0].eq_ptr(leaf)
+    assert dst.children[0].eq_ptr(dst.children[1])
+    assert dst.children[0].eq_ptr(dst.children[2].children[0])
+    assert dst.children[0].label == "leaf" and dst.children[2].label is None
+    shallow = copy.copy(root)
+    assert num_inits == 0
+    assert not shallow.eq_ptr(root) and shallow.children.eq_ptr(root.children)
+    del root, leaf
+    assert dst.children[2].value == 3
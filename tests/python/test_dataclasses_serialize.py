@@ -1,8 +1,11 @@
+import io
 import json
+import pathlib
 import pickle
 from typing import Optional
 
 import mlc
+import pytest
 
 
 @mlc.dataclasses.py_class("mlc.testing.serialize")
@@ -68,3 +71,91 @@ def test_json_opt_1() -> None:
     assert obj.b == obj_from_json.b
     assert obj.c == obj_from_json.c
     assert obj.d == obj_from_json.d
+
+
+def test_json_float_shortest() -> None:
+    for b in [0.1, 2.0, -0.0, 1e-30, 123456.789, 1.7976931348623157e308]:
+        obj = ObjTest(1, b, "3", True)
+        obj_json = obj.json()
+        assert f", {b!r}, " in obj_json
+        obj_from_json: ObjTest = ObjTest.from_json(obj_json)
+        assert isinstance(obj_from_json.b, float)
+        assert obj_from_json.b == b
+        assert str(obj_from_json.b) == str(b)
+
+
+def test_from_json_layout() -> None:
+    # Whitespace, the order of the sections and unknown sections do not matter
+    src = (
+        ' { "type_keys" : [ "mlc.testing.serialize", "int" ] , "extra": {"a": [1, "]"]},'
+        ' "values" : [ "3" , [ 0 , [ 1 , 1 ] , 2.0 , 0 , true ] ] } '
+    )
+    obj: ObjTest = ObjTest.from_json(src)
+    assert (obj.a, obj.b, obj.c, obj.d) == (1, 2.0, "3", True)
+
+
+def test_from_json_error() -> None:
+    type_keys = '"type_keys": ["mlc.testing.serialize", "int"]'
+    with pytest.raises(ValueError, match="referring #1 at #1"):
+        ObjTest.from_json('{"values": ["3", [0, [1, 1], 2.0, 1, true]], ' + type_keys + "}")
+    with pytest.raises(ValueError, match="Invalid type index: 2"):
+        ObjTest.from_json('{"values": ["3", [2, [1, 1], 2.0, 0, true]], ' + type_keys + "}")
+    with pytest.raises(ValueError, match="`type_keys` is missing"):
+        ObjTest.from_json('{"values": ["3"]}')
+
+
+def test_bytes() -> None:
+    obj = ObjTestOpt(-(2**63), 0.1, "3" * 100, False)
+    shared = mlc.List([1, None, "s"])
+    root = mlc.List(
+        [obj, shared, shared, mlc.Dict({"k": obj, 2: -1.5}), mlc.Device("cuda:1"), mlc.DataType("int8x4")]
+    )
+    data = root.to_bytes()
+    assert isinstance(data, bytes)
+    assert len(data) < len(root.json())
+    result = mlc.List.from_bytes(data)
+    assert list(result[1]) == [1, None, "s"]
+    assert result[1].eq_ptr(result[2])
+    assert result[3][2] == -1.5
+    assert result[4] == mlc.Device("cuda:1")
+    assert result[5] == mlc.DataType("int8x4")
+    assert result[3]["k"].eq_ptr(result[0])
+    assert (result[0].a, result[0].b, result[0].c, result[0].d) == (-(2**63), 0.1, "3" * 100, False)
+
+
+def test_bytes_error() -> None:
+    data = mlc.List([1, 2]).to_bytes()
+    with pytest.raises(ValueError, match="Magic number mismatch"):
+        mlc.List.from_bytes(b"\0" * len(data))
+    with pytest.raises(ValueError, match="Unexpected EOF"):
+        mlc.List.from_bytes(data[:-1])
+
+
+def test_dump_load() -> None:
+    root = mlc.List([ObjTest(i, i / 2, "é" * (i % 7), i % 2 == 0) for i in range(30000)])
+    for binary in [False, True]:
+        buffer = io.BytesIO()
+        mlc.dump(root, buffer, binary=binary)
+        assert buffer.getvalue() == (root.to_bytes() if binary else root.json().encode("utf-8"))
+        buffer.seek(0)
+        assert mlc.load(buffer, binary=binary).json() == root.json()
+    text = io.StringIO()
+    mlc.dump(root, text)
+    assert text.getvalue() == root.json()
+    text.seek(0)
+    assert mlc.load(text).json() == root.json()
+
+
+def test_dump_load_file(tmp_path: pathlib.Path) -> None:
+    root = mlc.List([ObjTest(1, 2.0, "3", True), mlc.Dict({"k": "v"})])
+    for binary in [False, True]:
+        path = tmp_path / "obj.mlc"
+        with open(path, "wb") as f:
+            f.write(b"header")
+            mlc.dump(root, f, binary=binary)
+        with open(path, "rb") as f:
+            assert f.read(6) == b"header"
+            result = mlc.load(f, binary=binary)
+            assert f.read() == b""
+        assert (result[0].a, result[0].b, result[0].c, result[0].d) == (1, 2.0, "3", True)
+        assert result[1]["k"] == "v"
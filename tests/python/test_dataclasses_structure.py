@@ -1,8 +1,11 @@
 from __future__ import annotations
 
+from typing import Any
+
 import mlc
 import mlc.dataclasses as mlcd
 import pytest
+from mlc._cython.base import MLCHeader
 
 
 @mlcd.py_class
@@ -71,6 +74,17 @@ class AssignStmt(Stmt):
     lhs: Var = mlcd.field(structure="bind")
 
 
+@mlcd.py_class(frozen=True, structure="nobind")
+class FrozenConstant(Expr):
+    value: int
+
+
+@mlcd.py_class(frozen=True, structure="nobind")
+class FrozenAdd(Expr):
+    a: Expr
+    b: Expr
+
+
 def test_free_var_1() -> None:
     x = Var("x")
     lhs = x
@@ -338,3 +352,139 @@ def test_global_var() -> None:
     rhs = x + z + y
     lhs.eq_s(rhs, bind_free_vars=True, assert_mode=True)
     assert lhs.hash_s() == rhs.hash_s()
+
+
+def test_nested_container_path() -> None:
+    lhs = mlc.Dict({"k": mlc.List([1, mlc.List([2, "x"])]), "j": mlc.List([mlc.Dict({1: None})])})
+    rhs = mlc.Dict({"k": mlc.List([1, mlc.List([2, "y"])]), "j": mlc.List([mlc.Dict({1: None})])})
+    with pytest.raises(ValueError) as e:
+        lhs.eq_s(rhs, assert_mode=True)
+    assert str(e.value) == 'Structural equality check failed at {root}["k"][1][1]: x vs y'
+
+    lhs = mlc.List([mlc.Dict({1: mlc.List([None])})])
+    rhs = mlc.List([mlc.Dict({1: mlc.List(["a long string here"])})])
+    with pytest.raises(ValueError) as e:
+        lhs.eq_s(rhs, assert_mode=True)
+    assert str(e.value) == "Structural equality check failed at {root}[0][1][0]: None vs object.Str"
+
+
+def test_hash_memo() -> None:
+    c = [FrozenConstant(i) for i in range(5)]
+    tree = FrozenAdd(FrozenAdd(c[0], c[1]), FrozenAdd(c[2], c[3]))
+    with pytest.raises(AttributeError):
+        tree.a = c[4]  # type: ignore[misc]
+    memo = mlc.StructuralHashMemo()
+    assert tree.hash_s(memo=memo) == tree.hash_s()
+    assert len(memo) == 7
+    # Only the edited path is rehashed
+    edited = FrozenAdd(tree.a, FrozenAdd(c[2], c[4]))
+    assert edited.hash_s(memo=memo) == edited.hash_s()
+    assert len(memo) == 10
+    # Subtrees with variables or lists are never memoized
+    x = Var("x")
+    for root in [Add(x, tree), FrozenAdd(x, edited), Add(tree, x)]:
+        assert root.hash_s(memo=memo) == root.hash_s()
+    assert mlc.List([tree, edited]).hash_s(memo=memo) == mlc.List([tree, edited]).hash_s()
+    assert len(memo) == 10
+
+
+def test_hash_s128() -> None:
+    x = Var("x")
+    lhs = Let(rhs=Constant(1), lhs=x, body=Add(x, Constant(2)))
+    y = Var("y")
+    rhs = Let(rhs=Constant(1), lhs=y, body=Add(y, Constant(2)))
+    other = Let(rhs=Constant(1), lhs=y, body=Add(y, Constant(3)))
+    assert lhs.hash_s128() == rhs.hash_s128()
+    assert lhs.hash_s128() != other.hash_s128()
+    assert 0 <= lhs.hash_s128() < 2**128
+    assert mlc.List(["s", "a long string here"]).hash_s128() == mlc.List(
+        [mlc.Str("s"), "a long string here"]
+    ).hash_s128()
+
+
+def test_hash_cons() -> None:
+    table = mlc.HashCons()
+    x = Var("x")
+    let = Let(rhs=Add(Constant(1), Constant(2)), lhs=x, body=Add(x, Add(Constant(1), Constant(2))))
+    root = mlc.List([let, Add(Constant(1), Constant(2)), Constant(1)])
+    interned = table.intern(root)
+    assert interned.eq_s(root)
+    assert interned[0].rhs.eq_ptr(interned[0].body.b)
+    assert interned[0].rhs.eq_ptr(interned[1])
+    assert interned[2].eq_ptr(interned[1].a)
+    assert table.intern(interned).eq_ptr(interned)
+    assert table.canonicalize(Add(Constant(1), Constant(2))).eq_ptr(interned[1])
+    # Distinct free variables are never merged
+    y, z = table.intern(mlc.List([Var("y"), Var("y")]))
+    assert not y.eq_ptr(z)
+
+
+def test_hash_cons_shared_free_var() -> None:
+    table = mlc.HashCons()
+    x = Var("x")
+    y = Var("x")
+    a, b, c = table.intern(mlc.List([Add(x, Constant(1)), Add(x, Constant(1)), Add(y, Constant(1))]))
+    assert a.eq_ptr(b)
+    assert not a.eq_ptr(c)
+    # Variables keep their identity, even if their names are merged
+    assert a.a.eq_ptr(x)
+    assert c.a.eq_ptr(y)
+    assert table.canonicalize(Add(x, Constant(1))).eq_ptr(a)
+
+
+def test_hash_cons_keeps_no_duplicate() -> None:
+    def ref_cnt(obj: Any) -> int:
+        return MLCHeader.from_address(obj._mlc_address).ref_cnt
+
+    table = mlc.HashCons()
+    canon = table.intern(Add(Constant(1), Constant(2)))
+    dup = Add(Constant(1), Constant(2))
+    dup_ref_cnt, child_ref_cnt = ref_cnt(dup), ref_cnt(dup.a)
+    assert table.intern(dup).eq_ptr(canon)
+    assert table.canonicalize(dup).eq_ptr(canon)
+    # Nothing in the table refers to the duplicate or its children, which are freed once dropped
+    assert ref_cnt(dup) == dup_ref_cnt
+    assert ref_cnt(dup.a) == child_ref_cnt
+
+
+def test_hash_s_many() -> None:
+    x = Var("x")
+    objs = [
+        *(Add(Constant(i), Constant(i + 1)) for i in range(100)),
+        Let(rhs=Constant(1), lhs=x, body=x),
+        mlc.List([1, "s"]),
+    ]
+    assert mlc.hash_s_many(objs) == [obj.hash_s() for obj in objs]
+    assert mlc.hash_s_many([]) == []
+
+
+def test_eq_s_many() -> None:
+    x, y = Var("x"), Var("y")
+    pairs = [(Add(Constant(i), Constant(1)), Add(Constant(i % 2), Constant(1))) for i in range(100)]
+    pairs.append((Let(rhs=Constant(1), lhs=x, body=x), Let(rhs=Constant(1), lhs=y, body=y)))
+    pairs.append((Add(x, Constant(1)), Add(y, Constant(1))))
+    expected = [lhs.eq_s(rhs) for lhs, rhs in pairs]
+    assert mlc.eq_s_many(pairs) == expected
+    assert expected[:3] == [True, True, False]
+    assert mlc.eq_s_many(pairs, bind_free_vars=False) == expected[:-1] + [False]
+    with pytest.raises(ValueError, match="Expected a pair of objects to compare"):
+        mlc.eq_s_many([(x,)])
+
+
+def test_rewrite() -> None:
+    def fold(node: Any) -> Any:
+        if isinstance(node, Add) and isinstance(node.a, Constant) and isinstance(node.b, Constant):
+            return Constant(node.a.value + node.b.value)
+        return node
+
+    x = Var("x")
+    kept = Add(x, Constant(1))
+    root = Let(rhs=Add(Constant(1), Add(Constant(2), Constant(3))), lhs=x, body=kept)
+    ret = mlc.rewrite(root, fold)
+    y = Var("y")
+    assert ret.eq_s(Let(rhs=Constant(6), lhs=y, body=Add(y, Constant(1))))
+    assert ret.lhs.eq_ptr(x)
+    assert ret.body.eq_ptr(kept)
+    assert isinstance(root.rhs, Add)
+    assert mlc.rewrite(ret, fold).eq_ptr(ret)
+    assert mlc.rewrite(mlc.List([kept, kept]), fold)[1].eq_ptr(kept)